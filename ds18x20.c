@@ -62,7 +62,7 @@ uint8_t		Fam10Count, Fam28Count, Fam10_28Count ;
  * @return	Power status
  */
 int	ds18x20CheckPower(ds18x20_t * psDS18X20) {
-	if (OWResetCommand(&psDS18X20->sOW, DS18X20_READ_PSU, 1) == 0) return 0 ;
+	if (OWResetCommand(&psDS18X20->sOW, DS18X20_READ_PSU, 1, 0) == 0) return 0 ;
 	psDS18X20->Pwr = OWReadBit(&psDS18X20->sOW) ;					// return status 0=parasitic 1=external
 	IF_PRINT(debugPOWER, "PSU=%s\n", psDS18X20->Pwr ? "Ext" : "Para") ;
 	return psDS18X20->Pwr ;
@@ -81,23 +81,44 @@ int	ds18x20CheckPower(ds18x20_t * psDS18X20) {
  *	OWBlock		163/860 per byte, 326/1720 for temperature, 815/4300 for all.
  *	Total Time	1969/10808 for temperature
  */
+static int ds18x20ReadSPTry(ds18x20_t * psDS18X20, int32_t Len) {
+	for (int Try = 0; ; ++Try) {
+		if (OWResetCommand(&psDS18X20->sOW, DS18X20_READ_SP, 0, 0) == 0) return 0 ;
+		memset(psDS18X20->RegX, 0xFF, Len) ;			// 0xFF to read
+		OWBlock(&psDS18X20->sOW, psDS18X20->RegX, Len) ;
+		ds248x_t * psDS248X = ds248xDEV(psDS18X20->sOW.DevNum) ;
+		if (psDS248X->OWErr) {							// I2C failed, bytes unknown
+			if (ds248xRecover(psDS248X, psDS248X->ErrCls, Try) == 0) return 0 ;
+			continue ;
+		}
+		if (Len != SO_MEM(ds18x20_t, RegX)) {
+			OWReset(&psDS18X20->sOW) ;					// terminate read
+			return 1 ;
+		}
+		if (OWCheckCRC(psDS18X20->RegX, SO_MEM(ds18x20_t, RegX))) return 1 ;
+		if (ds248xRecover(psDS248X, ds248xERR_CRC, Try) == 0) return 0 ;
+	}
+}
+
 int	ds18x20ReadSP(ds18x20_t * psDS18X20, int32_t Len) {
-	if (OWResetCommand(&psDS18X20->sOW, DS18X20_READ_SP, 0) == 0) return 0 ;
-	memset(psDS18X20->RegX, 0xFF, Len) ;				// 0xFF to read
-	OWBlock(&psDS18X20->sOW, psDS18X20->RegX, Len) ;
-	if (Len == SO_MEM(ds18x20_t, RegX)) OWCheckCRC(psDS18X20->RegX, SO_MEM(ds18x20_t, RegX)) ;
-	else OWReset(&psDS18X20->sOW) ;						// terminate read
-	return 1 ;
+	IF_OWHIST_START(tH) ;
+	int iRV = ds18x20ReadSPTry(psDS18X20, Len) ;
+	IF_OWHIST_STOP(&OWP_Hist[owpH_READSP], tH) ;
+	return iRV ;
 }
 
 int	ds18x20WriteSP(ds18x20_t * psDS18X20) {
-	if (OWResetCommand(&psDS18X20->sOW, DS18X20_WRITE_SP, 0) == 0) return 0 ;
-	OWBlock(&psDS18X20->sOW, (uint8_t *) &psDS18X20->Thi, psDS18X20->sOW.ROM.Family == OWFAMILY_28 ? 3 : 2) ;	// Thi, Tlo [+Conf]
-	return 1 ;
+	ds248x_t * psDS248X = ds248xDEV(psDS18X20->sOW.DevNum) ;
+	for (int Try = 0; ; ++Try) {
+		if (OWResetCommand(&psDS18X20->sOW, DS18X20_WRITE_SP, 0, 0) == 0) return 0 ;
+		OWBlock(&psDS18X20->sOW, (uint8_t *) &psDS18X20->Thi, psDS18X20->sOW.ROM.Family == OWFAMILY_28 ? 3 : 2) ;	// Thi, Tlo [+Conf]
+		if (psDS248X->OWErr == 0) return 1 ;			// else rewrite all from the reset
+		if (ds248xRecover(psDS248X, psDS248X->ErrCls, Try) == 0) return 0 ;
+	}
 }
 
 int	ds18x20WriteEE(ds18x20_t * psDS18X20) {
-	if (OWResetCommand(&psDS18X20->sOW, DS18X20_COPY_SP, 0) == 0) return 0 ;
+	if (OWResetCommand(&psDS18X20->sOW, DS18X20_COPY_SP, 0, !psDS18X20->Pwr) == 0) return 0 ;
 	vTaskDelay(pdMS_TO_TICKS(ds18x20DELAY_SP_COPY)) ;
 	OWLevel(&psDS18X20->sOW, owPOWER_STANDARD) ;
 	return 1 ;
@@ -110,7 +131,7 @@ int	ds18x20TempRead(ds18x20_t * psDS18X20) { return ds18x20ReadSP(psDS18X20, 2)
 // ###################################### IRMACOS support ##########################################
 
 int	ds18x20Initialize(ds18x20_t * psDS18X20) {
-	if (ds18x20ReadSP(psDS18X20, SO_MEM(ds18x20_t, RegX))) return 0 ;
+	if (ds18x20ReadSP(psDS18X20, SO_MEM(ds18x20_t, RegX)) == 0) return 0 ;
 	psDS18X20->Res	= (psDS18X20->sOW.ROM.Family == OWFAMILY_28)
 					? (psDS18X20->fam28.Conf >> 5)
 					: owFAM28_RES9B ;
@@ -18,7 +18,9 @@
 
 #define	ds18x20SINGLE_DEVICE				0
 #define	ds18x20TRIGGER_GLOBAL				0
-#define	ds18x20DELAY_CONVERT				750
+#define	ds18x20DELAY_CONVERT				750					// mS, DS18S20 & 12 bit DS18B20 maximum
+#define	ds18x20CONV_POLL_MIN				50					// % of maximum before polling read slots
+#define	ds18x20CONV_POLL_MS					10					// read slot poll interval
 #define	ds18x20DELAY_SP_COPY				11
 
 #define	ds18x20T_SNS_MIN					1000
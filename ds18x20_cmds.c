@@ -35,6 +35,11 @@ cmnd_t saDS18Cmnd[] = {
 	{ "WREE",	CmndDS18WREE },
 } ;
 
+// 1-Wire platform wide, no DS18 channel parameter
+cmnd_t saOWCmnd[] = {
+	{ "HLTH",	CmndOWHLTH },
+} ;
+
 // ##################################### CLI functionality #########################################
 
 int32_t	CmndDS18RDSP(cli_t * psCLI) {
@@ -52,6 +57,11 @@ int32_t	CmndDS18WREE(cli_t * psCLI) {
 	return erSUCCESS ;
 }
 
+int32_t	CmndOWHLTH(cli_t * psCLI) {
+	OWP_ReportHealth() ;
+	return erSUCCESS ;
+}
+
 int32_t	CmndDS18(cli_t * psCLI) {
 	int32_t iRV = erFAILURE ;
 	psCLI->pasList	= saDS18Cmnd ;
@@ -71,3 +81,11 @@ int32_t	CmndDS18(cli_t * psCLI) {
 	}
 	return iRV ;
 }
+
+int32_t	CmndOW(cli_t * psCLI) {
+	psCLI->pasList	= saOWCmnd ;
+	psCLI->u8LSize	= NO_MEM(saOWCmnd) ;
+	psCLI->pcParse	+= xStringSkipDelim(psCLI->pcParse, sepSPACE_COMMA, psCLI->pcStore - psCLI->pcParse ) ;
+	int32_t	i32SC = xCLImatch(psCLI) ;
+	return (i32SC >= 0) ? psCLI->pasList[i32SC].hdlr(psCLI) : erFAILURE ;
+}
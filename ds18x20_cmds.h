@@ -37,6 +37,8 @@ int32_t	CmndDS18RDSP(cli_t * psCLI) ;
 int32_t	CmndDS18WRSP(cli_t * psCLI) ;
 int32_t	CmndDS18WREE(cli_t * psCLI) ;
 int32_t CmndDS18(cli_t * psCLI) ;
+int32_t	CmndOWHLTH(cli_t * psCLI) ;
+int32_t	CmndOW(cli_t * psCLI) ;
 
 #ifdef __cplusplus
 }
@@ -13,6 +13,11 @@
 
 #include	<string.h>
 
+#if		(ds248xBUILD_EMUL > 0)
+	#include	"ds248x_emul.h"
+	#define	halI2C_Queue			ds248xEmulQueue
+#endif
+
 #define	debugFLAG					0xF007
 
 #define	debugBUS_CFG				(debugFLAG & 0x0001)
@@ -26,8 +31,6 @@
 
 // ##################################### Developer notes ###########################################
 /*
-	Test at 400KHx I2C speed, maybe add auto detect and step up mode in SCAN routine?
-	Add support to configure the PADJ register timing?
  */
 
 // ###################################### General macros ###########################################
@@ -40,25 +43,79 @@ const char * const StatNames[8] = { "OWB", "PPD", "SD", "LL", "RST", "SBR", "TSB
 
 // DS2482-800 only CHAN register xlat	0	  1		2	  3		4	  5		6	  7
 static const uint8_t ds248x_V2N[8] = { 0xB8, 0xB1, 0xAA, 0xA3, 0x9C, 0x95, 0x8E, 0x87 } ;
-// DS2484 only reporting/debugging
+// DS2484 only reporting/debugging, standard speed
 static const uint8_t Trstl[16]	= { 44, 46, 48, 50, 52, 54, 56, 58, 60, 62, 64, 66, 68, 70, 72, 74 } ;
 static const uint8_t Tmsp0[16]	= { 58, 58, 60, 62, 64, 66, 68, 70, 72, 74, 76, 76, 76, 76, 76, 76 } ;
-static const uint8_t Tmsp1[16]	= { 55, 55, 60, 65, 70, 75, 80, 85, 90, 95, 100, 105, 110, 110, 110, 110 } ;
 static const uint8_t Twol0[16]	= { 52, 54, 56, 58, 60, 62, 64, 66, 68, 70, 70, 70, 70, 70, 70, 70 } ;
-static const uint8_t Twol1[16]	= { 50, 55, 60, 65, 70, 75, 80, 85, 90, 95, 100, 100, 100, 100, 100, 100 } ;
 static const uint16_t Trec0[16]	= { 275, 275, 275, 275, 275, 275, 525, 775, 1025, 1275, 1525, 1775, 2025, 2275, 2525, 2525 } ;
 static const uint16_t Rwpu[16]	= { 500, 500, 500, 500, 500, 500, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000 } ;
 
+// Nominal 1-Wire delays, Standard & Overdrive, indexed by ds248xOP_*
+static const uint16_t ds248xDelay[2][ds248xOP_NUM] = {
+	{ owDELAY_RST, owDELAY_WB, owDELAY_RB, owDELAY_ST, owDELAY_SB },
+	{ owDELAY_RST_OD, owDELAY_WB_OD, owDELAY_RB_OD, owDELAY_ST_OD, owDELAY_SB_OD },
+} ;
+
 // ############################### Forward function declarations ###################################
 
 int		ds248xReset(ds248x_t * psDS248X) ;
+static int ds248xRecLevel(int eErr, int Try) ;
 
 // ################################ Local ONLY utility functions ###################################
 
-int ds248xLogError(ds248x_t * psDS248X, char const * pcMess) {
-	SL_ERR("Dev=%d Ch=%d %s error", psDS248X->psI2C->DevIdx, psDS248X->CurChan, pcMess) ;
-	ds248xReset(psDS248X) ;
-	return 0 ;
+static owhist_t	sHistNull ;								// sink until ds248xConfig() allocated psHist
+
+#if		(ds248xBUILD_TRACE > 0)
+static ds248x_trace_t	saTrace[ds248xTRACE_SIZE] ;
+static uint32_t			TraceIdx = 0 ;					// next record, free running
+static bool				TraceOn = 1 ;
+
+static void ds248xTraceAdd(ds248x_t * psDS248X, uint8_t * pTxBuf, size_t TxSize, uint32_t uSdly, uint32_t Time, int iRV) {
+	if (TraceOn == 0) return ;
+	ds248x_trace_t * psT = &saTrace[__atomic_fetch_add(&TraceIdx, 1, __ATOMIC_RELAXED) & (ds248xTRACE_SIZE - 1)] ;
+	psT->Time	= Time ;
+	psT->Delay	= (uSdly > UINT16_MAX) ? UINT16_MAX : uSdly ;
+	psT->Dev	= psDS248X->psI2C->DevIdx ;
+	psT->Chan	= psDS248X->CurChan ;
+	psT->OK		= (iRV == erSUCCESS) ;
+	for (int i = 0; i < sizeof(psT->Tx); ++i) psT->Tx[i] = (i < TxSize) ? pTxBuf[i] : 0 ;
+	psT->Rx		= psDS248X->RegX[psDS248X->Rptr] ;
+	psT->Rptr	= psDS248X->Rptr ;
+	psT->TxLen	= TxSize ;
+}
+#endif
+
+static owhist_t * ds248xHist(ds248x_t * psDS248X, int H) {
+	return psDS248X->psHist ? &psDS248X->psHist[H] : &sHistNull ;
+}
+
+#if		(ds248xBUILD_I2C_SPEED > 0)
+// I2C speeds negotiated, slowest first, HAL i2cSPEED_* codes need not be contiguous
+static const uint8_t ds248xSpeedTab[] = {
+	i2cSPEED_100, i2cSPEED_400,
+	#if	(ds248xI2C_1MHZ > 0)
+	i2cSPEED_1000,										// DS2484 only
+	#endif
+} ;
+
+static int ds248xSpeedIdx(uint8_t Speed) {
+	int Idx = NO_MEM(ds248xSpeedTab) - 1 ;
+	while (Idx > 0 && ds248xSpeedTab[Idx] != Speed) --Idx ;
+	return Idx ;
+}
+#endif
+
+/**
+ * @brief	Drop to the next lower I2C speed, I2C errors not cured by retry or read back mismatch
+ */
+static void ds248xSpeedDown(ds248x_t * psDS248X) {
+#if		(ds248xBUILD_I2C_SPEED > 0)
+	int Idx = ds248xSpeedIdx(psDS248X->psI2C->Speed) ;
+	if (Idx == 0) return ;
+	psDS248X->psI2C->Speed = ds248xSpeedTab[Idx - 1] ;
+	++psDS248X->SpeedDown ;
+	SL_ERR("Dev=%d I2C speed down to %d", psDS248X->psI2C->DevIdx, psDS248X->psI2C->Speed) ;
+#endif
 }
 
 int	ds248xCheckRead(ds248x_t * psDS248X, uint8_t Value) {
@@ -76,22 +133,26 @@ int	ds248xCheckRead(ds248x_t * psDS248X, uint8_t Value) {
 		}
 		psDS248X->PrvStat[psDS248X->CurChan] = psDS248X->Rstat ;
 #endif
-		// XXX Check if causing error if not blocking in I2C task
-		if (psDS248X->OWB) return ds248xLogError(psDS248X, "OWB") ;
+		if (psDS248X->OWB && psDS248X->Poll == 0) {		// recovered by ds248xI2C_WriteWaitRead()
+			psDS248X->ErrCls = ds248xERR_OWB ;
+			return 0 ;
+		}
 
 	} else if (psDS248X->Rptr == ds248xREG_CONF) {
-		if (Value != psDS248X->Rconf) {
+		// Only verify after WCFG, read back has upper nibble as 0
+		if (Value != 0xFF && (Value & 0x0F) != psDS248X->Rconf) {
 			char caBuf[18] ;
 			ds248x_conf_t sConf = { .Rconf = Value } ;
 			char * pcMess	= (psDS248X->APU != sConf.OWS) ? "OWS"
 							: (psDS248X->SPU != sConf.SPU) ? "SPU"
 							: (psDS248X->SPU != sConf.SPU) ? "PDN": "APU" ;
 			snprintfx(caBuf, sizeof(caBuf), "W=x%02X R=x%02X (%s)", pcMess) ;
-			return ds248xLogError(psDS248X, pcMess) ;
+			IF_SL_INFO(debugTRACK, "CONF %s", caBuf) ;
+			return ds248xRecover(psDS248X, ds248xERR_RDBK, 0) ;
 		}
 
 	} else if (psDS248X->Rptr == ds248xREG_CHAN && psDS248X->Rchan != ds248x_V2N[psDS248X->CurChan]) {
-		return ds248xLogError(psDS248X, "CHAN") ;
+		return ds248xRecover(psDS248X, ds248xERR_RDBK, 0) ;
 	}
 	return iRV ;
 }
@@ -100,14 +161,22 @@ int	ds248xI2C_Read(ds248x_t * psDS248X) {
 	#if (d248xAUTO_LOCK == 1)
 	xRtosSemaphoreTake(&psDS248X->mux, portMAX_DELAY) ;
 	#endif
-	IF_myASSERT(debugBUS_CFG, psDS248X->OWB == 0) ;
+	IF_myASSERT(debugBUS_CFG, psDS248X->OWB == 0 || psDS248X->Poll) ;
+	#if	(ds248xBUILD_TRACE > 0)
+	uint32_t Time = OWHistMicros() ;
+	#endif
 	int iRV = halI2C_Queue(psDS248X->psI2C, i2cR_B,
 			&psDS248X->RegX[psDS248X->Rptr], SO_MEM(ds248x_t, Rconf),
 			NULL, 0, (i2cq_p1_t) NULL, (i2cq_p2_t) NULL) ;
+	#if	(ds248xBUILD_TRACE > 0)
+	ds248xTraceAdd(psDS248X, NULL, 0, 0, Time, iRV) ;
+	#endif
 	#if (d248xAUTO_LOCK == 1)
 	xRtosSemaphoreGive(&psDS248X->mux) ;
 	#endif
-	if (iRV == erSUCCESS) return ds248xCheckRead(psDS248X, 0) ;
+	if (iRV == erSUCCESS) return ds248xCheckRead(psDS248X, 0xFF) ;
+	psDS248X->ShdRptr = 0 ;
+	psDS248X->ErrCls = ds248xERR_I2C ;
 	return 0 ;
 }
 
@@ -116,14 +185,106 @@ int	ds248xI2C_WriteDelayRead(ds248x_t * psDS248X, uint8_t * pTxBuf, size_t TxSiz
 	xRtosSemaphoreTake(&psDS248X->mux, portMAX_DELAY) ;
 	#endif
 	IF_myASSERT(debugBUS_CFG, psDS248X->OWB == 0) ;
+	#if	(ds248xBUILD_TRACE > 0)
+	uint32_t Time = OWHistMicros() ;
+	#endif
 	int iRV = halI2C_Queue(psDS248X->psI2C, i2cWDR_B,
 			pTxBuf, TxSize,
 			&psDS248X->RegX[psDS248X->Rptr], 1,
 			(i2cq_p1_t) uSdly, (i2cq_p2_t) NULL) ;
+	#if	(ds248xBUILD_TRACE > 0)
+	ds248xTraceAdd(psDS248X, pTxBuf, TxSize, uSdly, Time, iRV) ;
+	#endif
 	#if (d248xAUTO_LOCK == 1)
 	xRtosSemaphoreGive(&psDS248X->mux) ;
 	#endif
-	if (iRV == erSUCCESS) return ds248xCheckRead(psDS248X, pTxBuf[1]) ;
+	if (iRV == erSUCCESS) return ds248xCheckRead(psDS248X, (pTxBuf[0] == ds248xCMD_WCFG) ? pTxBuf[1] : 0xFF) ;
+	psDS248X->ShdConf = psDS248X->ShdRptr = 0 ;			// command may or may not have executed
+	psDS248X->ErrCls = ds248xERR_I2C ;
+	return 0 ;
+}
+
+/**
+ * @brief	Keep the SPU shadow in step with the hardware
+ * @note	SPU=1 arms the strong pullup, it starts after the next 1WWB/1WSB and ends (with the
+ *			CONF SPU bit cleared by the device) at the start of the following 1-Wire command.
+ *			Once active SPU is dropped from Rconf, no later WCFG (speed, ReSelect) re-arms it.
+ */
+static void ds248xTrackSPU(ds248x_t * psDS248X, int Op) {
+	if (psDS248X->SpuOn) {
+		psDS248X->SpuOn	= 0 ;
+	} else if (psDS248X->SPU && (Op == ds248xOP_WB || Op == ds248xOP_SB)) {
+		psDS248X->SpuOn	= 1 ;
+		psDS248X->SPU	= 0 ;
+	}
+}
+
+/**
+ * @brief	Write 1-Wire command (or resume polling a busy one), wait for completion & read STAT
+ * @return	1 if completed with STAT read, 0 if I2C error or 1WB stuck with ErrCls set
+ */
+static int ds248xWriteWaitOnce(ds248x_t * psDS248X, uint8_t * pTxBuf, size_t TxSize, int Op, bool Resume) {
+	uint32_t uSdly = ds248xDelay[psDS248X->OWS][Op] ;
+#if		(ds248xWAIT_MODE == ds248xWAIT_ADAPTIVE)
+	uint8_t * pPct = &psDS248X->Pct[psDS248X->CurChan][Op] ;
+	uSdly = (uSdly * *pPct) >> 7 ;
+	psDS248X->Poll = 1 ;
+	int iRV = Resume ? ds248xI2C_Read(psDS248X) : ds248xI2C_WriteDelayRead(psDS248X, pTxBuf, TxSize, uSdly) ;
+	int Count = 0 ;
+	while (iRV == 1 && psDS248X->OWB && Count < ds248xPOLL_MAX) {
+		iRV = ds248xI2C_Read(psDS248X) ;
+		++Count ;
+	}
+	psDS248X->Poll = 0 ;
+	if (iRV == 0) return 0 ;
+	if (psDS248X->OWB) {
+		psDS248X->ErrCls = ds248xERR_OWB ;
+		return 0 ;
+	}
+	if (Resume) return 1 ;								// delay already learned
+	if (Count) {
+		*pPct = ((*pPct + (Count * ds248xPCT_GROW)) > ds248xPCT_MAX) ? ds248xPCT_MAX : *pPct + (Count * ds248xPCT_GROW) ;
+	} else if (*pPct > ds248xPCT_MIN) {
+		*pPct -= ds248xPCT_SHRINK ;
+	}
+	return 1 ;
+#else
+	if (Resume == 0) return ds248xI2C_WriteDelayRead(psDS248X, pTxBuf, TxSize, uSdly) ;
+	psDS248X->Poll = 1 ;
+	int iRV = ds248xI2C_Read(psDS248X) ;
+	psDS248X->Poll = 0 ;
+	if (iRV == 1 && psDS248X->OWB) {
+		psDS248X->ErrCls = ds248xERR_OWB ;
+		return 0 ;
+	}
+	return iRV ;
+#endif
+}
+
+/**
+ * @brief	Write 1-Wire command, wait for completion & read STAT
+ * @param	Op - ds248xOP_* operation, selects nominal delay & learned fraction
+ * @return	1 if completed with STAT read, 0 if failed with ErrCls & OWErr set
+ * @note	Adaptive mode sleeps for the learned (per channel & operation) fraction of the
+ *			nominal delay then polls STAT until 1WB clears. No poll required shrinks the
+ *			next delay, each extra poll grows it.
+ *			A busy line is polled again after the ds248xRecover() back off. The command is
+ *			never re-issued, after an I2C error it may or may not have executed and a repeat
+ *			could duplicate a byte or triplet. The failure is left for the caller to retry
+ *			the complete transaction (reset, address & command).
+ */
+int	ds248xI2C_WriteWaitRead(ds248x_t * psDS248X, uint8_t * pTxBuf, size_t TxSize, int Op) {
+	uint8_t Rptr = psDS248X->Rptr ;
+	psDS248X->PostRst = 0 ;
+	ds248xTrackSPU(psDS248X, Op) ;
+	for (int Try = 0; ; ++Try) {
+		psDS248X->Rptr = Rptr ;
+		if (ds248xWriteWaitOnce(psDS248X, pTxBuf, TxSize, Op, Try > 0)) return 1 ;
+		if (psDS248X->ErrCls != ds248xERR_OWB || psDS248X->OWB == 0) break ;
+		if (ds248xRecLevel(ds248xERR_OWB, Try) != ds248xREC_RETRY) break ;	// reset would abort it
+		if (ds248xRecover(psDS248X, ds248xERR_OWB, Try) == 0) break ;
+	}
+	psDS248X->OWErr = 1 ;
 	return 0 ;
 }
 
@@ -150,14 +311,16 @@ int ds248xReset(ds248x_t * psDS248X) {
 	//  SS status byte to read to verify state
 	uint8_t	cChr 	= ds248xCMD_DRST ;
 	psDS248X->Rptr	= ds248xREG_STAT ;					// After ReSeT pointer set to STATus register
-	IF_SYSTIMER_START(debugTIMING, stDS248xA) ;
+	IF_OWHIST_START(tH) ;
 	ds248xI2C_WriteDelayRead(psDS248X, &cChr, sizeof(cChr), 0) ;
-	IF_SYSTIMER_STOP(debugTIMING, stDS248xA) ;
+	IF_OWHIST_STOP(ds248xHist(psDS248X, ds248xH_REG), tH) ;
 	psDS248X->Rdata		= 0 ;
 	psDS248X->Rconf		= 0 ;							// all bits cleared (default) config
 	psDS248X->CurChan	= 0 ;
 	psDS248X->Rchan		= ds248x_V2N[0] ;				// DS2482-800 specific
 	psDS248X->Rpadj		= 0 ;							// DS2484 specific
+	psDS248X->SpuOn		= 0 ;
+	psDS248X->ShdConf	= psDS248X->ShdRptr = psDS248X->RST ;
 	return psDS248X->RST ;
 }
 
@@ -180,12 +343,28 @@ int	ds248xWriteConfig(ds248x_t * psDS248X) {
 	uint8_t	config	= psDS248X->Rconf & 0x0F ;
 	uint8_t	cBuf[2] = { ds248xCMD_WCFG , (~config << 4) | config } ;
 	psDS248X->Rptr = ds248xREG_CONF ;
-	IF_SYSTIMER_START(debugTIMING, stDS248xA) ;
+	IF_OWHIST_START(tH) ;
 	int iRV = ds248xI2C_WriteDelayRead(psDS248X, cBuf, sizeof(cBuf), 0) ;
-	IF_SYSTIMER_STOP(debugTIMING, stDS248xA) ;
+	IF_OWHIST_STOP(ds248xHist(psDS248X, ds248xH_WCFG), tH) ;
+	psDS248X->ShdConf	= iRV ;
+	psDS248X->SpuOn		= 0 ;							// armed or ended by this write
 	return iRV ;
 }
 
+/**
+ * @brief	Set or clear CONF bit(s), WCFG suppressed if the hardware already matches
+ * @return	1 if CONF (now) matches else 0
+ */
+int	ds248xUpdateConfig(ds248x_t * psDS248X, uint8_t Mask, bool Set) {
+	uint8_t Conf = Set ? (psDS248X->Rconf | Mask) : (psDS248X->Rconf & ~Mask) ;
+	if (psDS248X->ShdConf && Conf == psDS248X->Rconf) {
+		++psDS248X->NoWCFG ;
+		return 1 ;
+	}
+	psDS248X->Rconf = Conf ;
+	return ds248xWriteConfig(psDS248X) ;
+}
+
 /**
  * @brief	Set the Read Pointer and reads the register
  *			Once set the pointer remains static to allow reread of same register
@@ -200,17 +379,20 @@ int	ds248xWriteConfig(ds248x_t * psDS248X) {
 int	ds248xReadRegister(ds248x_t * psDS248X, uint8_t Reg) {
 	// check for validity of CHAN (only DS2482-800) and PADJ (only DS2484)
 	int iRV ;
-	if ((Reg == ds248xREG_CHAN && psDS248X->psI2C->Type != i2cDEV_DS2482_800) ||
-		(Reg == ds248xREG_PADJ && psDS248X->psI2C->Type != i2cDEV_DS2484)) {
+	if ((Reg == ds248xREG_CHAN && !ds248xIS_TYPE(psDS248X, i2cDEV_DS2482_800)) ||
+		(Reg == ds248xREG_PADJ && !ds248xIS_TYPE(psDS248X, i2cDEV_DS2484))) {
 		ds248xPrintConfig(psDS248X, Reg) ;
 		printfx("Invalid register combination!!!\n") ;
 		iRV = 0 ;
+	} else if (psDS248X->ShdRptr && psDS248X->Rptr == Reg && Reg != ds248xREG_PADJ) {
+		++psDS248X->NoSRP ;								// pointer already set, PADJ auto increments
+		iRV = ds248xI2C_Read(psDS248X) ;
 	} else {
 		psDS248X->Rptr	= Reg ;
 		uint8_t	cBuf[2] = { ds248xCMD_SRP, (~Reg << 4) | Reg } ;
-		IF_SYSTIMER_START(debugTIMING, stDS248xA) ;
+		IF_OWHIST_START(tH) ;
 		iRV = ds248xI2C_WriteDelayRead(psDS248X, cBuf, sizeof(cBuf), 0) ;
-		IF_SYSTIMER_STOP(debugTIMING, stDS248xA) ;
+		IF_OWHIST_STOP(ds248xHist(psDS248X, ds248xH_REG), tH) ;
 	}
 	return iRV ;
 }
@@ -228,25 +410,47 @@ int	ds248xReadRegister(ds248x_t * psDS248X, uint8_t Reg) {
  *	NS	0		300		75
  *	OD	0		300		75
  */
+static int ds248xChanSelect(ds248x_t * psDS248X, uint8_t Bus) {
+	/* Channel Select (Case A)
+	 *	S AD,0 [A] CHSL [A] CC [A] Sr AD,1 [A] [RR] A\ P
+	 *  [] indicates from slave
+	 *  CC channel value
+	 *  RR channel read back
+	 */
+	if (psDS248X->SpuOn) ds248xWriteConfig(psDS248X) ;	// CHSL does not end it, WCFG (SPU=0) does
+	uint8_t	cBuf[2] = { ds2482CMD_CHSL, ~Bus<<4 | Bus } ;	// calculate Channel value
+	uint8_t Prev	= psDS248X->CurChan ;
+	psDS248X->Rptr	= ds248xREG_CHAN ;
+	psDS248X->CurChan	= Bus ;				// save in advance, read back checked against it
+	IF_OWHIST_START(tH) ;
+	int iRV = ds248xI2C_WriteDelayRead(psDS248X, cBuf, sizeof(cBuf), 0) ;
+	IF_OWHIST_STOP(ds248xHist(psDS248X, ds248xH_CHSL), tH) ;
+	if (iRV == 0) psDS248X->CurChan = Prev ;			// not known to be selected, next select retries
+	return iRV ;
+}
+
+/**
+ * @brief	Lock the device & select the channel
+ * @return	1 if selected & locked, 0 if CHSL failed with the device left unlocked
+ */
 int	ds248xBusSelect(ds248x_t * psDS248X, uint8_t Bus) {
+#if (d248xAUTO_LOCK == 2)
+	SemaphoreHandle_t mux = psDS248X->mux ;				// aligned copy, ds248x_t is packed
+	xRtosSemaphoreTake(&mux, portMAX_DELAY) ;			// CHSL (& WCFG) under the lock
+	psDS248X->mux = mux ;								// may have been created by the take
+#endif
 	int iRV = 1 ;
-	if ((psDS248X->psI2C->Type == i2cDEV_DS2482_800)
+	if ((ds248xIS_TYPE(psDS248X, i2cDEV_DS2482_800))
 	&& (psDS248X->CurChan != Bus))	{					// optimise to avoid unnecessary IO
-		/* Channel Select (Case A)
-		 *	S AD,0 [A] CHSL [A] CC [A] Sr AD,1 [A] [RR] A\ P
-		 *  [] indicates from slave
-		 *  CC channel value
-		 *  RR channel read back
-		 */
-		uint8_t	cBuf[2] = { ds2482CMD_CHSL, ~Bus<<4 | Bus } ;	// calculate Channel value
-		psDS248X->Rptr	= ds248xREG_CHAN ;
-		psDS248X->CurChan	= Bus ;			// save in advance will auto resset if error
-		IF_SYSTIMER_START(debugTIMING, stDS248xA) ;
-		iRV = ds248xI2C_WriteDelayRead(psDS248X, cBuf, sizeof(cBuf), 0) ;
-		IF_SYSTIMER_STOP(debugTIMING, stDS248xA) ;
+		iRV = ds248xChanSelect(psDS248X, Bus) ;
+	} else if (ds248xIS_TYPE(psDS248X, i2cDEV_DS2482_800)) {
+		++psDS248X->NoCHSL ;
 	}
 #if (d248xAUTO_LOCK == 2)
-	xRtosSemaphoreTake(&psDS248X->mux, portMAX_DELAY) ;
+	if (iRV == 0) {
+		xRtosSemaphoreGive(&mux) ;
+		psDS248X->mux = mux ;
+	}
 #endif
 	return iRV ;
 }
@@ -257,6 +461,85 @@ void ds248xBusRelease(ds248x_t * psDS248X) {
 #endif
 }
 
+// ################################ Error classification & recovery ################################
+
+static const char * const ErrNames[ds248xERR_NUM] = { "I2C", "OWB", "SD", "CRC", "RDBK" } ;
+static const char * const RecNames[ds248xREC_NUM] = { "Retry", "ReSel", "Reset", "Fail" } ;
+
+// Recovery levels applicable per error class, a short or bad CRC is not cured by a reset
+static const uint8_t RecPath[ds248xERR_NUM] = {
+	[ds248xERR_I2C]		= (1 << ds248xREC_RETRY) | (1 << ds248xREC_RESEL) | (1 << ds248xREC_RESET),
+	[ds248xERR_OWB]		= (1 << ds248xREC_RETRY) | (1 << ds248xREC_RESET),
+	[ds248xERR_SD]		= (1 << ds248xREC_RETRY),
+	[ds248xERR_CRC]		= (1 << ds248xREC_RETRY),
+	[ds248xERR_RDBK]	= (1 << ds248xREC_RESEL) | (1 << ds248xREC_RESET),
+} ;
+
+static int ds248xRecLevel(int eErr, int Try) {
+	for (int Level = ds248xREC_RETRY; Level < ds248xREC_FAIL; ++Level) {
+		if ((RecPath[eErr] & (1 << Level)) == 0) continue ;
+		int Tries = (Level == ds248xREC_RETRY) ? ds248xREC_RETRIES : 1 ;
+		if (Try < Tries) return Level ;
+		Try -= Tries ;
+	}
+	return ds248xREC_FAIL ;
+}
+
+/**
+ * @brief	Restore channel & CONF of this device only, other channels untouched
+ */
+static int ds248xReSelect(ds248x_t * psDS248X) {
+	int iRV = 1 ;
+	if (ds248xIS_TYPE(psDS248X, i2cDEV_DS2482_800)) iRV = ds248xChanSelect(psDS248X, psDS248X->CurChan) ;
+	if (iRV == 1) iRV = ds248xWriteConfig(psDS248X) ;
+	return iRV ;
+}
+
+/**
+ * @brief	Device reset then restore PADJ, channel & CONF as before the reset
+ */
+static int ds248xReInit(ds248x_t * psDS248X) {
+	uint8_t Chan = psDS248X->CurChan ;
+	uint8_t Conf = psDS248X->Rconf ;
+	ds248xReConfig(psDS248X->psI2C) ;
+	psDS248X->CurChan	= Chan ;
+	psDS248X->Rconf		= Conf ;
+	return ds248xReSelect(psDS248X) ;
+}
+
+int	ds248xRecover(ds248x_t * psDS248X, int eErr, int Try) {
+	++psDS248X->Err[eErr] ;
+	if (eErr == ds248xERR_CRC) OWP_BusEvent(psDS248X->Lo + psDS248X->CurChan, owbiEV_CRC) ;
+	else if (eErr == ds248xERR_OWB) OWP_BusEvent(psDS248X->Lo + psDS248X->CurChan, owbiEV_BUSY) ;
+	if (psDS248X->InRec) return 0 ;						// failed inside recovery, caller escalates
+	int Level = ds248xRecLevel(eErr, Try) ;
+	int iRV = 1 ;
+	psDS248X->InRec = 1 ;
+	if (Level == ds248xREC_RETRY) {
+		vTaskDelay(pdMS_TO_TICKS(ds248xREC_BACKOFF << Try)) ;
+	} else if (Level == ds248xREC_RESEL) {
+		if (eErr == ds248xERR_I2C || eErr == ds248xERR_RDBK) ds248xSpeedDown(psDS248X) ;
+		iRV = ds248xReSelect(psDS248X) ;
+		if (iRV == 0 && (RecPath[eErr] & (1 << ds248xREC_RESET))) {
+			++psDS248X->Rec[Level] ;
+			Level = ds248xREC_RESET ;					// escalate immediately
+		}
+	}
+	if (Level == ds248xREC_RESET) {
+		OWP_BusEvent(psDS248X->Lo + psDS248X->CurChan, owbiEV_DEVRST) ;
+		iRV = ds248xReInit(psDS248X) ;
+	}
+	if (Level == ds248xREC_FAIL) iRV = 0 ;
+	psDS248X->InRec = 0 ;
+	++psDS248X->Rec[iRV ? Level : ds248xREC_FAIL] ;
+	if (Level < ds248xREC_RESET && iRV) {
+		IF_SL_INFO(debugTRACK, "Dev=%d Ch=%d %s error, %s", psDS248X->psI2C->DevIdx, psDS248X->CurChan, ErrNames[eErr], RecNames[Level]) ;
+	} else {
+		SL_ERR("Dev=%d Ch=%d %s error, %s", psDS248X->psI2C->DevIdx, psDS248X->CurChan, ErrNames[eErr], RecNames[iRV ? Level : ds248xREC_FAIL]) ;
+	}
+	return iRV ;
+}
+
 // #################################### DS248x debug/reporting #####################################
 
 int	 ds248xReportStatus(uint8_t Num, ds248x_stat_t Stat) {
@@ -293,37 +576,30 @@ int	ds248xReportRegister(ds248x_t * psDS248X, int Reg, bool Refresh) {
 		iRV += printfx("DATA(1)=0x%02X (Last read)\n", psDS248X->Rdata) ;
 		break ;
 	case ds248xREG_CHAN:
-		if ((psDS248X->psI2C->Type != i2cDEV_DS2482_800)
-		|| (Refresh && ds248xReadRegister(psDS248X, Reg) == 0)) return 0 ;
+		if (!ds248xIS_TYPE(psDS248X, i2cDEV_DS2482_800)) return 0 ;
+		// shadow valid unless a failed transaction left the channel unknown
+		if (Refresh && psDS248X->ShdRptr == 0 && ds248xReadRegister(psDS248X, Reg) == 0) return 0 ;
 		// Channel, start by finding the matching Channel #
 		for (Chan = 0; Chan < psDS248X->NumChan && psDS248X->Rchan != ds248x_V2N[Chan]; ++Chan) ;
 		IF_myASSERT(debugRESULT, Chan < psDS248X->NumChan && psDS248X->Rchan == ds248x_V2N[Chan]) ;
 		iRV = printfx("CHAN(2)=0x%02X Chan=%d Xlat=0x%02X\n", psDS248X->Rchan, Chan, ds248x_V2N[Chan]) ;
 		break ;
 	case ds248xREG_CONF:
-		if (Refresh && ds248xReadRegister(psDS248X, Reg) == 0) return 0 ;
-		iRV += printfx("CONF(3)=0x%02X  1WS=%c  SPU=%c  PDN=%c  APU=%c\n",
+		if (Refresh && psDS248X->ShdConf == 0 && ds248xReadRegister(psDS248X, Reg) == 0) return 0 ;
+		iRV += printfx("CONF(3)=0x%02X  1WS=%c  SPU=%c  PDN=%c  APU=%c%s\n",
 				psDS248X->Rconf,
 				psDS248X->OWS	? '1' : '0',
 				psDS248X->SPU	? '1' : '0',
 				psDS248X->PDN	? '1' : '0',
-				psDS248X->APU	? '1' : '0') ;
+				psDS248X->APU	? '1' : '0',
+				psDS248X->ShdConf ? "" : " (unverified)") ;
 		break ;
-	case ds248xREG_PADJ:
-		if (Refresh == 0) return 0 ;
-		if (psDS248X->psI2C->Type != i2cDEV_DS2484 || ds248xReadRegister(psDS248X, Reg) == 0) return 0 ;
-		iRV += printfx("PADJ=0x%02X  OD=%c | tRSTL=%duS | tMSP=", psDS248X->Rpadj,
-				psDS248X->OD ? '1' : '0', Trstl[psDS248X->VAL] * (psDS248X->OD ? 1 : 10)) ;
-		ds248xI2C_Read(psDS248X) ;
-		iRV += printfx(psDS248X->OD ? "%duS" : "%.1fuS",
-				psDS248X->OD ? (float) Tmsp1[psDS248X->VAL] / 10.0 : Tmsp0[psDS248X->VAL]) ;
-		ds248xI2C_Read(psDS248X) ;
-		iRV += printfx(psDS248X->OD ? " | tWOL=%duS" : " | tWOL=%.1fuS",
-				psDS248X->OD ? (float) Twol1[psDS248X->VAL] / 10.0 : Twol0[psDS248X->VAL]) ;
-		ds248xI2C_Read(psDS248X) ;
-		iRV += printfx(" | tREC0=%.2fuS", (float) Trec0[psDS248X->VAL] / 100.0) ;
-		ds248xI2C_Read(psDS248X) ;
-		iRV += printfx(" | rWPU=%f ohm\n", (float) Rwpu[psDS248X->VAL]) ;
+	case ds248xREG_PADJ:								// standard speed values from shadow
+		if (!ds248xIS_TYPE(psDS248X, i2cDEV_DS2484)) return 0 ;
+		iRV += printfx("PADJ OD=0 | tRSTL=%duS | tMSP=%duS | tWOL=%duS | tREC0=%.2fuS | rWPU=%d ohm\n",
+				Trstl[psDS248X->Padj[ds2484PAR_TRSTL]] * 10, Tmsp0[psDS248X->Padj[ds2484PAR_TMSP]],
+				Twol0[psDS248X->Padj[ds2484PAR_TW0L]], (float) Trec0[psDS248X->Padj[ds2484PAR_TREC0]] / 100.0,
+				Rwpu[psDS248X->Padj[ds2484PAR_RWPU]]) ;
 		break ;
 	}
 	return iRV ;
@@ -335,7 +611,67 @@ int	ds248xReportRegister(ds248x_t * psDS248X, int Reg, bool Refresh) {
 void ds248xReport(ds248x_t * psDS248X, bool Refresh) {
 	halI2C_DeviceReport((void *) psDS248X->psI2C) ;
 	for (int Reg = 0; Reg < ds248xREG_NUM; ds248xReportRegister(psDS248X, Reg++, Refresh)) ;
+	printfx("Suppressed WCFG=%u SRP=%u CHSL=%u  I2C Speed=%d Max=%d Down=%u\n", psDS248X->NoWCFG,
+			psDS248X->NoSRP, psDS248X->NoCHSL, psDS248X->psI2C->Speed, psDS248X->SpeedMax, psDS248X->SpeedDown) ;
+	#if	(ds248xBUILD_ASYNC > 0)
+	if (ds248xNUM_CHAN(psDS248X) > 1) printfx("Async ReOrder=%u CHSL=%u (in order %u)\n", psDS248X->ReOrder,
+			psDS248X->ChslDone, psDS248X->ChslFifo) ;
+	#endif
+	printfx("Errors") ;
+	for (int i = 0; i < ds248xERR_NUM; ++i) printfx(" %s=%u", ErrNames[i], psDS248X->Err[i]) ;
+	printfx("  Recovery") ;
+	for (int i = 0; i < ds248xREC_NUM; ++i) printfx(" %s=%u", RecNames[i], psDS248X->Rec[i]) ;
 	printfx("\n") ;
+	ds248xReportHist(psDS248X, 0) ;
+	printfx("\n") ;
+}
+
+#if		(ds248xBUILD_TRACE > 0)
+void ds248xTraceEnable(bool Enable) { TraceOn = Enable ; }
+
+size_t	ds248xTraceExport(uint8_t * pBuf, size_t Size) {
+	if (Size < sizeof(ds248x_trace_hdr_t)) return 0 ;
+	uint32_t Last = __atomic_load_n(&TraceIdx, __ATOMIC_RELAXED) ;
+	uint32_t Count = (Last < ds248xTRACE_SIZE) ? Last : ds248xTRACE_SIZE ;
+	if (Count > (Size - sizeof(ds248x_trace_hdr_t)) / sizeof(ds248x_trace_t)) {
+		Count = (Size - sizeof(ds248x_trace_hdr_t)) / sizeof(ds248x_trace_t) ;	// keep the newest
+	}
+	ds248x_trace_hdr_t sHdr = { { 'D', 'T' }, 2, sizeof(ds248x_trace_t), Count } ;
+	memcpy(pBuf, &sHdr, sizeof(sHdr)) ;
+	ds248x_trace_t * psT = (ds248x_trace_t *) (pBuf + sizeof(sHdr)) ;
+	for (uint32_t i = Last - Count; i != Last; ++i) *psT++ = saTrace[i & (ds248xTRACE_SIZE - 1)] ;
+	return sizeof(sHdr) + (Count * sizeof(ds248x_trace_t)) ;
+}
+
+/**
+ * ds248xTraceReport() - decode the newest Count trace records, oldest first
+ */
+void ds248xTraceReport(int Count) {
+	uint32_t Last = __atomic_load_n(&TraceIdx, __ATOMIC_RELAXED) ;
+	if (Count > ds248xTRACE_SIZE) Count = ds248xTRACE_SIZE ;
+	if (Count > Last) Count = Last ;
+	for (uint32_t i = Last - Count; i != Last; ++i) {
+		ds248x_trace_t * psT = &saTrace[i & (ds248xTRACE_SIZE - 1)] ;
+		printfx("%10u D=%u C=%u ", psT->Time, psT->Dev, psT->Chan) ;
+		if (psT->TxLen) printfx("Tx=%02X", psT->Tx[0]) ; else printfx("Rd   ") ;
+		for (int j = 1; j < sizeof(psT->Tx); ++j) {
+			if (j < psT->TxLen) printfx(",%02X", psT->Tx[j]) ; else printfx("   ") ;
+		}
+		printfx(" Dly=%-4u %s=%02X%s\n", psT->Delay, RegNames[psT->Rptr], psT->Rx, psT->OK ? "" : " FAIL") ;
+	}
+}
+#endif
+
+/**
+ * ds248xReportHist() - report latency percentiles per command, optionally reset afterwards
+ */
+void ds248xReportHist(ds248x_t * psDS248X, bool Reset) {
+	static const char * const HistNames[ds248xH_NUM] = { "1WRS", "1WWB", "1WRB", "1WT", "1WSB", "CHSL", "WCFG", "REG" } ;
+	if (psDS248X->psHist == NULL) return ;
+	for (int H = 0; H < ds248xH_NUM; ++H) {
+		OWHistReport(HistNames[H], &psDS248X->psHist[H]) ;
+		if (Reset) OWHistSnapshot(NULL, &psDS248X->psHist[H], 1) ;
+	}
 }
 
 /**
@@ -343,6 +679,9 @@ void ds248xReport(ds248x_t * psDS248X, bool Refresh) {
  */
 void ds248xReportAll(bool Refresh) {
 	for (int i = 0; i < ds248xCount; ds248xReport(&psaDS248X[i++], Refresh)) ;
+#if		(ds248xBUILD_EMUL > 0)
+	ds248xEmulReport() ;
+#endif
 }
 
 // ################### Identification, Diagnostics & Configuration functions #######################
@@ -373,7 +712,11 @@ int	ds248xIdentify(i2c_di_t * psI2C_DI) {
 		}
 	}
 	psI2C_DI->Test	= 0 ;
+#if		(ds248xBUILD_I2C_SPEED > 0)
+	if (psI2C_DI->Type != i2cDEV_UNDEF) psI2C_DI->Speed = i2cSPEED_100 ;	// ds248xSpeedNegotiate() steps up
+#else
 	if (psI2C_DI->Type != i2cDEV_UNDEF) psI2C_DI->Speed = i2cSPEED_400 ;
+#endif
 #if (d248xAUTO_LOCK == 1)
 	if (sDS248X.mux) vSemaphoreDelete(sDS248X.mux) ;
 #endif
@@ -385,21 +728,31 @@ int	ds248xConfig(i2c_di_t * psI2C_DI) {
 		IF_myASSERT(debugPARAM, psI2C_DI->DevIdx == 0) ;
 		psaDS248X = malloc(ds248xCount * sizeof(ds248x_t)) ;
 		memset(psaDS248X, 0, ds248xCount * sizeof(ds248x_t)) ;
-		IF_SYSTIMER_INIT(debugTIMING, stDS248xA, stMICROS, "DS248xA", 100, 1000) ;
-		IF_SYSTIMER_INIT(debugTIMING, stDS248xB, stMICROS, "DS248xB", 200, 2000) ;
-		IF_SYSTIMER_INIT(debugTIMING, stDS248xC, stMICROS, "DS248xC", 10, 100) ;
-		IF_SYSTIMER_INIT(debugTIMING, stDS248xD, stMICROS, "DS248xD", 300, 3000) ;
-		IF_SYSTIMER_INIT(debugTIMING, stDS248xE, stMICROS, "DS248xE", 300, 3000) ;
-		IF_SYSTIMER_INIT(debugTIMING, stDS248xF, stMICROS, "DS248xF", 300, 3000) ;
-	}
-	ds248x_t * psDS248X = &psaDS248X[psI2C_DI->DevIdx] ;
+	}
+	ds248x_t * psDS248X = ds248xDEV(psI2C_DI->DevIdx) ;
 	psDS248X->psI2C		= psI2C_DI ;
+	// specialised builds must match the hardware detected
+	IF_myASSERT(debugPARAM, ds248xIS_TYPE(psDS248X, psI2C_DI->Type) && psI2C_DI->DevIdx < ds248xNUM_DEV) ;
+	memset(psDS248X->Pct, ds248xPCT_INIT, sizeof(psDS248X->Pct)) ;
+	memset(psDS248X->Padj, ds2484PADJ_DEFAULT, sizeof(psDS248X->Padj)) ;
+	#if	(owBUILD_HIST > 0)
+	psDS248X->psHist	= calloc(ds248xH_NUM, sizeof(owhist_t)) ;
+	#endif
 	switch(psI2C_DI->Type) {
 		case i2cDEV_DS2482_800:	psDS248X->NumChan = 8 ;	break ;
 		case i2cDEV_DS2482_10X:
 		case i2cDEV_DS2484:		psDS248X->NumChan = 1 ;	break ;
 	}
 	ds248xReConfig(psI2C_DI) ;
+	#if	(ds248xBUILD_I2C_SPEED > 0)
+	ds248xSpeedNegotiate(psDS248X) ;
+	#endif
+	#if	(ds248xBUILD_PADJ_CAL > 0)
+	if (psI2C_DI->Type == i2cDEV_DS2484) ds248xPortCalibrate(psDS248X) ;
+	#endif
+	#if	(ds248xBUILD_ASYNC > 0)
+	ds248xAsyncStart(psDS248X) ;
+	#endif
 	#if	(ds18x20BUILD_TASK == 1)
 	void OWP_TempReadSample(TimerHandle_t pxHandle) ;
 	psDS248X->tmr = xTimerCreate("ds248x", pdMS_TO_TICKS(5), pdFALSE, NULL, OWP_TempReadSample) ;
@@ -408,13 +761,61 @@ int	ds248xConfig(i2c_di_t * psI2C_DI) {
 }
 
 void ds248xReConfig(i2c_di_t * psI2C_DI) {
-	ds248x_t * psDS248X = &psaDS248X[psI2C_DI->DevIdx] ;
+	ds248x_t * psDS248X = ds248xDEV(psI2C_DI->DevIdx) ;
 	ds248xReset(psDS248X) ;
 	psDS248X->Rconf	= 0 ;
 	psDS248X->APU	= 1 ;								// LSBit
 	ds248xWriteConfig(psDS248X) ;
+	if (psI2C_DI->Type != i2cDEV_DS2484) return ;
+	for (int Par = 0; Par < ds2484PAR_NUM; ++Par) {	// restore calibrated values lost by DRST
+		if (psDS248X->Padj[Par] != ds2484PADJ_DEFAULT) ds248xPortAdjust(psDS248X, Par, 0, psDS248X->Padj[Par]) ;
+	}
 }
 
+#if		(ds248xBUILD_I2C_SPEED > 0)
+/**
+ * @brief	Read back CONF (and select each channel on a DS2482-800) ds248xI2C_PROBES times
+ * @return	1 if all read backs matched else 0
+ */
+static int ds248xSpeedProbe(ds248x_t * psDS248X) {
+	uint8_t Conf = psDS248X->Rconf ;
+	for (int i = 0; i < ds248xI2C_PROBES; ++i) {
+		psDS248X->ShdRptr = 0 ;							// force SRP, exercise write & read
+		int iRV = ds248xReadRegister(psDS248X, ds248xREG_CONF) ;
+		iRV = (iRV == 1 && psDS248X->Rconf == Conf) ;
+		psDS248X->Rconf = Conf ;
+		if (iRV && ds248xIS_TYPE(psDS248X, i2cDEV_DS2482_800)) {
+			iRV = ds248xBusSelect(psDS248X, (psDS248X->CurChan + 1) % ds248xNUM_CHAN(psDS248X)) ;
+			if (iRV) ds248xBusRelease(psDS248X) ;
+		}
+		if (iRV == 0) return 0 ;
+	}
+	return 1 ;
+}
+
+int	ds248xSpeedNegotiate(ds248x_t * psDS248X) {
+	i2c_di_t * psI2C = psDS248X->psI2C ;
+	int Max = ds248xIS_TYPE(psDS248X, i2cDEV_DS2484) ? NO_MEM(ds248xSpeedTab) - 1 : ds248xSpeedIdx(i2cSPEED_400) ;
+	int Idx = 0 ;
+	bool Fail = 0 ;
+	while (Idx < Max) {
+		psI2C->Speed = ds248xSpeedTab[Idx + 1] ;
+		if (ds248xSpeedProbe(psDS248X) == 0) {
+			Fail = 1 ;
+			break ;
+		}
+		++Idx ;
+	}
+	uint8_t Speed			= ds248xSpeedTab[Idx] ;
+	psI2C->Speed			= Speed ;
+	psDS248X->SpeedMax		= Speed ;
+	psDS248X->SpeedDown		= 0 ;
+	if (Fail) ds248xReConfig(psI2C) ;					// failed probe may have reset the device
+	IF_SL_INFO(debugCONFIG, "Dev=%d I2C speed=%d%s", psI2C->DevIdx, Speed, Fail ? " (limited)" : "") ;
+	return Speed ;
+}
+#endif
+
 // ################################## DS248x-x00 1-Wire functions ##################################
 
 /**
@@ -425,8 +826,7 @@ void ds248xReConfig(i2c_di_t * psI2C_DI) {
  *	OD	0		300		75
  */
 int	ds248xOWSetSPU(ds248x_t * psDS248X) {
-	psDS248X->SPU = 1 ;
-	int iRV = ds248xWriteConfig(psDS248X) ;
+	ds248xUpdateConfig(psDS248X, ds248xCONF_SPU, 1) ;
 	return psDS248X->SPU ;
 }
 
@@ -449,24 +849,41 @@ int	ds248xOWReset(ds248x_t * psDS248X) {
 //						Repeat until 1WB bit has changed to 0
 //  [] indicates from slave
 	// No SPU == 0 checking, will be reset by itself...
+	// A reset starts a new transaction, safe to repeat whatever happened to the previous one
 	uint8_t	cChr = ds248xCMD_1WRS ;
-	psDS248X->Rptr	= ds248xREG_STAT ;
-	IF_SYSTIMER_START(debugTIMING, stDS248xB) ;
-	ds248xI2C_WriteDelayRead(psDS248X, &cChr, sizeof(cChr), psDS248X->OWS ? owDELAY_RST_OD : owDELAY_RST) ;
-	IF_SYSTIMER_STOP(debugTIMING, stDS248xB) ;
+	for (int Try = 0; ; ++Try) {
+		psDS248X->OWErr	= 0 ;
+		psDS248X->Rptr	= ds248xREG_STAT ;
+		IF_OWHIST_START(tH) ;
+		int iRV = ds248xI2C_WriteWaitRead(psDS248X, &cChr, sizeof(cChr), ds248xOP_RST) ;
+		IF_OWHIST_STOP(ds248xHist(psDS248X, ds248xH_RST), tH) ;
+		if (iRV == 0) {
+			if (ds248xRecover(psDS248X, psDS248X->ErrCls, Try) == 0) return 0 ;
+			continue ;
+		}
+		OWP_BusEvent(psDS248X->Lo + psDS248X->CurChan, owbiEV_RESET) ;
+		if (psDS248X->SD) OWP_BusEvent(psDS248X->Lo + psDS248X->CurChan, owbiEV_SD) ;
+		if (psDS248X->SD == 0 || ds248xRecover(psDS248X, ds248xERR_SD, Try) == 0) break ;
+	}
+	if (psDS248X->PPD == 0) OWP_BusEvent(psDS248X->Lo + psDS248X->CurChan, owbiEV_NOPPD) ;
+	// standard speed reset returns all devices on the channel to standard speed
+	if (psDS248X->OWS == owSPEED_STANDARD) OWP_BusODSet(psDS248X->Lo + psDS248X->CurChan, 0ULL) ;
+	psDS248X->PostRst = psDS248X->PPD ;
 	return psDS248X->PPD ;
 }
 
 int	ds248xOWSpeed(ds248x_t * psDS248X, bool speed) {
-	psDS248X->OWS = speed ;
-	ds248xWriteConfig(psDS248X) ;
+	ds248xUpdateConfig(psDS248X, ds248xCONF_1WS, speed) ;
 	return psDS248X->OWS ;
 }
 
 int	ds248xOWLevel(ds248x_t * psDS248X, bool level) {
-	if (level == owPOWER_STRONG) return psDS248X->SPU ;	// DS248X only allow STANDARD
-	psDS248X->SPU = level ;
-	ds248xWriteConfig(psDS248X) ;
+	if (level == owPOWER_STRONG) return psDS248X->SPU || psDS248X->SpuOn ;	// DS248X only allow STANDARD
+	if (psDS248X->SpuOn) {								// bridge ends it at the next 1-Wire cmd
+		++psDS248X->NoWCFG ;
+		return owPOWER_STANDARD ;
+	}
+	ds248xUpdateConfig(psDS248X, ds248xCONF_SPU, level) ;
 	return psDS248X->SPU ;
 }
 
@@ -480,9 +897,9 @@ uint8_t ds248xOWTouchBit(ds248x_t * psDS248X, uint8_t Bit) {
 	IF_myASSERT(debugPARAM, Bit < 2) ;
 	uint8_t	cBuf[2] = {	ds248xCMD_1WSB, Bit ? 0x80 : 0x00 } ;
 	psDS248X->Rptr	= ds248xREG_STAT ;
-	IF_SYSTIMER_START(debugTIMING, stDS248xC) ;
-	ds248xI2C_WriteDelayRead(psDS248X, cBuf, sizeof(cBuf), psDS248X->OWS ? owDELAY_SB_OD : owDELAY_SB) ;
-	IF_SYSTIMER_STOP(debugTIMING, stDS248xC) ;
+	IF_OWHIST_START(tH) ;
+	ds248xI2C_WriteWaitRead(psDS248X, cBuf, sizeof(cBuf), ds248xOP_SB) ;
+	IF_OWHIST_STOP(ds248xHist(psDS248X, ds248xH_SB), tH) ;
 	return psDS248X->SBR ;
 }
 
@@ -502,14 +919,43 @@ void ds248xOWWriteByte(ds248x_t * psDS248X, uint8_t Byte) {
 //  DD data to write
 	uint8_t	cBuf[2] = { ds248xCMD_1WWB, Byte } ;
 	psDS248X->Rptr	= ds248xREG_STAT ;
-	IF_SYSTIMER_START(debugTIMING, stDS248xD) ;
-	ds248xI2C_WriteDelayRead(psDS248X, cBuf, sizeof(cBuf), psDS248X->OWS ? owDELAY_WB_OD : owDELAY_WB) ;
-	IF_SYSTIMER_STOP(debugTIMING, stDS248xD) ;
+	IF_OWHIST_START(tH) ;
+	ds248xI2C_WriteWaitRead(psDS248X, cBuf, sizeof(cBuf), ds248xOP_WB) ;
+	IF_OWHIST_STOP(ds248xHist(psDS248X, ds248xH_WB), tH) ;
 }
 
+/**
+ *	WWDR		100KHz	400KHz
+ *				500uS	125uS
+ *		uS-----+------+-------+
+ *	NS	560		1060	685
+ *	OD	88		588		213
+ */
 int		ds248xOWWriteBytePower(ds248x_t * psDS248X, uint8_t Byte) {
+#if		(ds248xBUILD_WB_SPU > 0)
+// Write config then 1-Wire Write Byte (Case B)
+//	S AD,0 [A] WCFG [A] CF [A] 1WWB [A] DD [A] Sr AD,1 [A] [Status] A [Status] A\ P
+//												   \--------/
+//									Repeat until 1WB bit has changed to 0
+//  [] indicates from slave
+//  CF configuration byte with SPU set, not read back, STAT is the 1WWB result
+	if (psDS248X->ShdConf && psDS248X->SPU && psDS248X->SpuOn == 0) {
+		++psDS248X->NoWCFG ;							// already armed, 1WWB only
+		ds248xOWWriteByte(psDS248X, Byte) ;
+		return psDS248X->SpuOn ;
+	}
+	uint8_t	Conf	= (psDS248X->Rconf | ds248xCONF_SPU) & 0x0F ;
+	uint8_t	cBuf[4] = { ds248xCMD_WCFG, (~Conf << 4) | Conf, ds248xCMD_1WWB, Byte } ;
+	psDS248X->Rconf	= Conf ;
+	psDS248X->SpuOn	= 0 ;								// WCFG ends an active strong pullup
+	psDS248X->Rptr	= ds248xREG_STAT ;
+	IF_OWHIST_START(tH) ;
+	if (ds248xI2C_WriteWaitRead(psDS248X, cBuf, sizeof(cBuf), ds248xOP_WB)) psDS248X->ShdConf = 1 ;
+	IF_OWHIST_STOP(ds248xHist(psDS248X, ds248xH_WB), tH) ;
+#else
 	if (ds248xOWSetSPU(psDS248X)) ds248xOWWriteByte(psDS248X, Byte) ;
-	return psDS248X->SPU ;
+#endif
+	return psDS248X->SpuOn ;
 }
 
 /**
@@ -526,13 +972,15 @@ uint8_t	ds248xOWReadByte(ds248x_t * psDS248X) {
  *							Repeat until 1WB bit has changed to 0
  *	Sr AD,0 [A] SRP [A] E1 [A] Sr AD,1 [A] DD A\ P
  *  [] indicates from slave
- *  DD data read	*/
+ *  DD data read
+ *	DATA only holds the new byte once 1WB has cleared, a combined 1WRB + SRP(DATA) job cannot
+ *	see 1WB, hence the learned delay & STAT poll first then SRP(DATA) + read as second job */
 	uint8_t	cBuf	= ds248xCMD_1WRB ;
 	psDS248X->Rptr	= ds248xREG_STAT ;
-	IF_SYSTIMER_START(debugTIMING, stDS248xE) ;
-	ds248xI2C_WriteDelayRead(psDS248X, &cBuf, sizeof(cBuf), psDS248X->OWS ? owDELAY_RB_OD : owDELAY_RB) ;
-	IF_SYSTIMER_STOP(debugTIMING, stDS248xE) ;
-	ds248xReadRegister(psDS248X, ds248xREG_DATA) ;
+	IF_OWHIST_START(tH) ;
+	int iRV = ds248xI2C_WriteWaitRead(psDS248X, &cBuf, sizeof(cBuf), ds248xOP_RB) ;
+	IF_OWHIST_STOP(ds248xHist(psDS248X, ds248xH_RB), tH) ;
+	if (iRV == 0 || ds248xReadRegister(psDS248X, ds248xREG_DATA) == 0) psDS248X->OWErr = 1 ;
 	return psDS248X->Rdata ;
 }
 
@@ -546,8 +994,312 @@ uint8_t ds248xOWSearchTriplet(ds248x_t * psDS248X, uint8_t search_direction) {
 	IF_myASSERT(debugPARAM, search_direction < 2) ;
 	uint8_t	cBuf[2] = { ds248xCMD_1WT, search_direction ? 0x80 : 0x00 } ;
 	psDS248X->Rptr	= ds248xREG_STAT ;
-	IF_SYSTIMER_START(debugTIMING, stDS248xF) ;
-	ds248xI2C_WriteDelayRead(psDS248X, cBuf, sizeof(cBuf), psDS248X->OWS ? owDELAY_ST_OD : owDELAY_ST) ;
-	IF_SYSTIMER_STOP(debugTIMING, stDS248xF) ;
+	IF_OWHIST_START(tH) ;
+	ds248xI2C_WriteWaitRead(psDS248X, cBuf, sizeof(cBuf), ds248xOP_ST) ;
+	IF_OWHIST_STOP(ds248xHist(psDS248X, ds248xH_ST), tH) ;
 	return psDS248X->Rstat ;
 }
+
+/**
+ * @return	1 if ROM found, 0 if not (search state reset), erFAILURE if an I2C transaction failed
+ */
+static int ds248xOWSearchOnce(ds248x_t * psDS248X, ds248x_srch_t * psS) {
+	int LastZero = 0, Bit = 0 ;
+	psS->Bits = 0 ;
+	psS->Crc = 0 ;
+	if (psS->LDF == 0 && ds248xOWReset(psDS248X)) {
+		ds248xOWWriteByte(psDS248X, psS->Cmd) ;
+		for (; Bit < 64 && psDS248X->OWErr == 0; ++Bit) {
+			uint8_t * pByte = &psS->ROM[Bit >> 3], Mask = 1 << (Bit & 7) ;
+			// before LD repeat the previous path, at LD take 1, beyond it 0
+			bool Dir = ((Bit + 1) < psS->LD) ? ((*pByte & Mask) != 0) : ((Bit + 1) == psS->LD) ;
+			uint8_t Stat = ds248xOWSearchTriplet(psDS248X, Dir) ;
+			if (psDS248X->OWErr) break ;
+			if ((Stat & (ds248xSTAT_SBR | ds248xSTAT_TSB)) == (ds248xSTAT_SBR | ds248xSTAT_TSB)) break ;	// no devices
+			Dir = (Stat & ds248xSTAT_DIR) ? 1 : 0 ;
+			if ((Stat & (ds248xSTAT_SBR | ds248xSTAT_TSB)) == 0 && Dir == 0) {
+				LastZero = Bit + 1 ;
+				if (LastZero < 9) psS->LFD = LastZero ;
+			}
+			*pByte = Dir ? (*pByte | Mask) : (*pByte & ~Mask) ;
+		}
+		psS->Bits = Bit ;
+		if (psDS248X->OWErr) return erFAILURE ;		// outcome unknown, state left to caller
+		if (Bit == 64) {
+			psS->Crc = OWCrc8(0, psS->ROM, sizeof(psS->ROM)) ;
+			if (psS->Crc == 0 && psS->ROM[0] != 0) {
+				psS->LD = LastZero ;
+				psS->LDF = (LastZero == 0) ;
+				return 1 ;
+			}
+		}
+	}
+	psS->LD = psS->LFD = psS->LDF = 0 ;				// next search starts from the first device
+	return 0 ;
+}
+
+/**
+ * @brief	One complete search pass, reset, command & 64 triplets
+ * @note	A failed I2C transaction leaves the triplet outcome unknown, the pass is repeated
+ *			from the entry state (bounded by ds248xRecover()) rather than the triplet.
+ */
+int	ds248xOWSearch(ds248x_t * psDS248X, ds248x_srch_t * psS) {
+	ds248x_srch_t sEntry = *psS ;
+#if		(owBUILD_RESUME > 0)
+	// Search ROM clears all RC flags, also when run as ds248xREQ_SEARCH
+	if (psS->LDF == 0) OWP_BusResumeSet(psDS248X->Lo + psDS248X->CurChan, 0ULL) ;
+#endif
+	for (int Try = 0; ; ++Try) {
+		int iRV = ds248xOWSearchOnce(psDS248X, psS) ;
+		if (iRV != erFAILURE) return iRV ;
+		if (ds248xRecover(psDS248X, psDS248X->ErrCls, Try) == 0) break ;
+		*psS = sEntry ;
+	}
+	psS->LD = psS->LFD = psS->LDF = 0 ;				// next search starts from the first device
+	return 0 ;
+}
+
+// ################################ DS2484 1-Wire port adjustment ##################################
+
+/**
+ * @brief	Program one DS2484 port parameter
+ * @param	Par - ds2484PAR_* parameter selector
+ * @param	OD - 0 = standard speed value, 1 = overdrive value (tRSTL, tMSP & tW0L only)
+ * @param	Val - 0 -> 15, see Trstl/Tmsp0/Twol0/Trec0/Rwpu tables
+ * @return	1 if written (and read back matches if OD is the current speed) else 0
+ *
+ *	WWDR + 0..4 R	100KHz	400KHz
+ *				300uS	75uS
+ */
+int	ds248xPortAdjust(ds248x_t * psDS248X, uint8_t Par, bool OD, uint8_t Val) {
+	IF_myASSERT(debugPARAM, Par < ds2484PAR_NUM && Val < 16) ;
+	if (!ds248xIS_TYPE(psDS248X, i2cDEV_DS2484)) return 0 ;
+	/* Adjust 1-Wire Port (Case A)
+	 *	S AD,0 [A] PADJ [A] PP [A] Sr AD,1 [A] [P0] A [P1] A ... [P4] A\ P
+	 *  [] indicates from slave
+	 *  PP PAR(3) OD(1) VAL(4), read pointer left on PADJ, successive reads return P0 -> P4
+	 */
+	uint8_t	cBuf[2] = { ds2484CMD_PADJ, (Par << 5) | (OD << 4) | Val } ;
+	psDS248X->Rptr = ds248xREG_PADJ ;
+	IF_OWHIST_START(tH) ;
+	int iRV = ds248xI2C_WriteDelayRead(psDS248X, cBuf, sizeof(cBuf), 0) ;
+	IF_OWHIST_STOP(ds248xHist(psDS248X, ds248xH_REG), tH) ;
+	for (int i = 0; iRV == 1 && i < Par; ++i) iRV = ds248xI2C_Read(psDS248X) ;
+	if (iRV == 1 && OD == psDS248X->OWS && (psDS248X->PAR != Par || psDS248X->VAL != Val)) {
+		ds248xRecover(psDS248X, ds248xERR_RDBK, 1) ;	// only a reset restores PADJ
+		return 0 ;
+	}
+	if (iRV == 1 && OD == 0) psDS248X->Padj[Par] = Val ;
+	return iRV ;
+}
+
+/**
+ * @brief	Enumerate the whole bus ds2484CAL_ROUNDS times
+ * @return	1 if every round found Count devices, each with a valid ROM CRC, else 0
+ */
+static int ds248xPortTest(owdi_t * psOW, int Count) {
+	for (int Round = 0; Round < ds2484CAL_ROUNDS; ++Round) {
+		int Found = 0 ;
+		for (int iRV = OWFirst(psOW, 0); iRV; iRV = OWNext(psOW, 0)) ++Found ;
+		if (Found != Count) return 0 ;
+	}
+	return 1 ;
+}
+
+/**
+ * @brief	Shorten standard speed tRSTL, tW0L & tREC0 to the bus specific minimum
+ * @note	Each parameter is stepped down from the current value while the bus still
+ *			enumerates error free, then backed off by ds2484CAL_MARGIN steps. tMSP & rWPU
+ *			do not influence the slot duration and are left unchanged.
+ * @return	erSUCCESS if calibrated, erFAILURE if not DS2484 or no devices found
+ */
+int	ds248xPortCalibrate(ds248x_t * psDS248X) {
+	static const uint8_t CalPar[] = { ds2484PAR_TRSTL, ds2484PAR_TW0L, ds2484PAR_TREC0 } ;
+	if (!ds248xIS_TYPE(psDS248X, i2cDEV_DS2484)) return erFAILURE ;
+	owdi_t sOW = { 0 } ;
+	sOW.DevNum	= psDS248X->psI2C->DevIdx ;
+	if (ds248xBusSelect(psDS248X, 0) == 0) return erFAILURE ;
+	int Count = 0 ;
+	for (int iRV = OWFirst(&sOW, 0); iRV; iRV = OWNext(&sOW, 0)) ++Count ;
+	if (Count == 0 || ds248xPortTest(&sOW, Count) == 0) {
+		ds248xBusRelease(psDS248X) ;
+		return erFAILURE ;
+	}
+	for (int i = 0; i < NO_MEM(CalPar); ++i) {
+		uint8_t Par = CalPar[i] ;
+		int Val = psDS248X->Padj[Par] ;
+		while (Val > 0 && ds248xPortAdjust(psDS248X, Par, 0, Val - 1) && ds248xPortTest(&sOW, Count)) --Val ;
+		Val = ((Val + ds2484CAL_MARGIN) > 15) ? 15 : Val + ds2484CAL_MARGIN ;
+		ds248xPortAdjust(psDS248X, Par, 0, Val) ;
+	}
+	int iRV = ds248xPortTest(&sOW, Count) ;
+	if (iRV == 0) {										// marginal bus, back to datasheet defaults
+		for (int i = 0; i < NO_MEM(CalPar); ++i) ds248xPortAdjust(psDS248X, CalPar[i], 0, ds2484PADJ_DEFAULT) ;
+	}
+	ds248xBusRelease(psDS248X) ;
+	IF_SL_INFO(debugCONFIG, "DS2484 %d devices tRSTL=%duS tW0L=%duS tREC0=%.2fuS %s", Count,
+			Trstl[psDS248X->Padj[ds2484PAR_TRSTL]] * 10, Twol0[psDS248X->Padj[ds2484PAR_TW0L]],
+			(float) Trec0[psDS248X->Padj[ds2484PAR_TREC0]] / 100.0, iRV ? "OK" : "FAIL") ;
+	return iRV ? erSUCCESS : erFAILURE ;
+}
+
+// ############################## DS248x asynchronous request support ##############################
+
+/**
+ * @brief	Execute a single request, bus selected (and locked) as required
+ */
+static void ds248xAsyncExecute(ds248x_t * psDS248X, ds248x_req_t * psReq) {
+#if		(owBUILD_RESUME > 0)
+	// ROM commands written here bypass OWAddress(), RC flags on the bus no longer known
+	if (psReq->Cmd == ds248xREQ_RESET || psReq->Cmd == ds248xREQ_WRITE) OWP_BusResumeSet(psDS248X->Lo + psDS248X->CurChan, 0ULL) ;
+#endif
+	switch (psReq->Cmd) {
+	case ds248xREQ_SELECT:	psReq->Rdata = psDS248X->CurChan ;									break ;
+	case ds248xREQ_RESET:	psReq->Rdata = ds248xOWReset(psDS248X) ;							break ;
+	case ds248xREQ_WRITE:	ds248xOWWriteByte(psDS248X, psReq->Data) ; psReq->Rdata = psReq->Data ;	break ;
+	case ds248xREQ_READ:	psReq->Rdata = ds248xOWReadByte(psDS248X) ;							break ;
+	case ds248xREQ_TRIPLET:	psReq->Rdata = ds248xOWSearchTriplet(psDS248X, psReq->Data) ;		break ;
+	case ds248xREQ_BIT:		psReq->Rdata = ds248xOWTouchBit(psDS248X, psReq->Data) ;			break ;
+	case ds248xREQ_SEARCH:	psReq->Rdata = ds248xOWSearch(psDS248X, psReq->pvArg) ;			break ;
+	default:				psReq->iRV = 0 ;													return ;
+	}
+	psReq->Rstat	= psDS248X->Rstat ;
+	psReq->iRV		= 1 ;
+}
+
+/**
+ * @brief	Choose the next pending request, on a DS2482-800 prefer the current channel
+ * @param	Held - bus locked by a HOLD sequence of task hHold
+ * @return	index into papPend, -1 if held and nothing pending from hHold
+ * @note	A request only overtakes older ones if none of them is an EXEC job (selects buses
+ *			itself) or was submitted by the same task. Each task's requests and all requests
+ *			for a channel (hence for a 1-Wire device) thus complete in submission order.
+ *			The oldest request is overtaken at most ds248xASYNC_BYPASS times in succession.
+ *			ds248xREQF_PRIO requests go first, but only ahead of requests for other channels
+ *			from other tasks, never ahead of an EXEC job nor into a HOLD sequence. An EXEC
+ *			job or a single channel bridge leaves PRIO nothing to overtake.
+ *			During a HOLD sequence only the holder's requests are served, all others wait.
+ */
+static int ds248xAsyncPick(ds248x_t * psDS248X, ds248x_req_t ** papPend, int Count, bool Held, TaskHandle_t hHold, uint8_t * pBypass) {
+	if (Held) {
+		*pBypass = 0 ;
+		for (int i = 0; i < Count; ++i) if (papPend[i]->hTask == hHold) return i ;
+		return -1 ;
+	}
+	for (int i = 0; i < Count; ++i) {
+		ds248x_req_t * psReq = papPend[i] ;
+		if ((psReq->Flags & ds248xREQF_PRIO) == 0) continue ;
+		int j = 0 ;
+		while (j < i && psReq->Cmd != ds248xREQ_EXEC && papPend[j]->Cmd != ds248xREQ_EXEC &&
+			papPend[j]->hTask != psReq->hTask && papPend[j]->Chan != psReq->Chan) ++j ;
+		if (j < i) continue ;							// own task's or channel's earlier request first
+		*pBypass = 0 ;
+		return i ;
+	}
+	if (ds248xNUM_CHAN(psDS248X) == 1 || papPend[0]->Cmd == ds248xREQ_EXEC ||
+		papPend[0]->Chan == psDS248X->CurChan || *pBypass >= ds248xASYNC_BYPASS) {
+		*pBypass = 0 ;
+		return 0 ;
+	}
+	for (int i = 1; i < Count; ++i) {
+		ds248x_req_t * psReq = papPend[i] ;
+		if (psReq->Cmd == ds248xREQ_EXEC) break ;
+		if (psReq->Chan != psDS248X->CurChan) continue ;
+		int j = 0 ;
+		while (j < i && papPend[j]->hTask != psReq->hTask) ++j ;
+		if (j < i) break ;								// would overtake own task, keep channel order
+		++*pBypass ;
+		++psDS248X->ReOrder ;
+		return i ;
+	}
+	*pBypass = 0 ;
+	return 0 ;
+}
+
+/**
+ * @brief	Device worker, drains the queue then services requests grouped by channel
+ */
+static void ds248xAsyncTask(void * pvPara) {
+	ds248x_t * psDS248X = pvPara ;
+	ds248x_req_t * papPend[ds248xASYNC_DEPTH] ;
+	ds248x_req_t * psReq ;
+	TaskHandle_t hHold = NULL ;
+	int		Count = 0 ;
+	uint8_t	Bypass = 0, FifoChan = 0 ;
+	bool	Held = 0, Wait = 0 ;
+	while (1) {
+		int Prev = Count ;
+		if (Count == 0 || Wait) {
+			if (xQueueReceive(psDS248X->queue, &papPend[Count], Wait ? pdMS_TO_TICKS(ds248xASYNC_HOLD_MS) : portMAX_DELAY) != pdTRUE) {
+				if (Wait) {								// holder went quiet, end the sequence
+					ds248xBusRelease(psDS248X) ;
+					Held = Wait = 0 ;
+				}
+				continue ;
+			}
+			if (Count == 0) FifoChan = psDS248X->CurChan ;	// idle, in order & actual channel agree
+			++Count ;
+			Wait = 0 ;
+		}
+		while (Count < ds248xASYNC_DEPTH && xQueueReceive(psDS248X->queue, &papPend[Count], 0) == pdTRUE) ++Count ;
+		for (int i = Prev; i < Count; ++i) {			// CHSL count if run in submission order
+			if (papPend[i]->Cmd == ds248xREQ_EXEC || papPend[i]->Chan == FifoChan) continue ;
+			FifoChan = papPend[i]->Chan ;
+			++psDS248X->ChslFifo ;
+		}
+		int Idx = ds248xAsyncPick(psDS248X, papPend, Count, Held, hHold, &Bypass) ;
+		if (Idx < 0) {									// others wait for the holder's next request
+			Wait = (Count < ds248xASYNC_DEPTH) ;
+			if (Wait == 0) {							// no room to receive it, end the sequence
+				ds248xBusRelease(psDS248X) ;
+				Held = 0 ;
+			}
+			continue ;
+		}
+		psReq = papPend[Idx] ;
+		memmove(&papPend[Idx], &papPend[Idx + 1], (Count - Idx - 1) * sizeof(ds248x_req_t *)) ;
+		--Count ;
+		psReq->iRV = 0 ;
+		if (Held && (psReq->Cmd == ds248xREQ_EXEC || psReq->Chan != psDS248X->CurChan)) {
+			ds248xBusRelease(psDS248X) ;				// HOLD sequence broken, release
+			Held = 0 ;
+		}
+		if (psReq->Cmd == ds248xREQ_EXEC) {
+			psReq->cb(psDS248X, psReq) ;
+			psReq->iRV = 1 ;
+			if (psReq->hTask) xTaskNotifyGive(psReq->hTask) ;
+			continue ;
+		}
+		if (Held == 0 && psReq->Chan != psDS248X->CurChan) ++psDS248X->ChslDone ;
+		if (Held || ds248xBusSelect(psDS248X, psReq->Chan)) {
+			ds248xAsyncExecute(psDS248X, psReq) ;
+			Held = (psReq->Flags & ds248xREQF_HOLD) ? 1 : 0 ;
+			hHold = psReq->hTask ;
+			if (Held == 0) ds248xBusRelease(psDS248X) ;
+		}												// select failed, device left unlocked
+		if (psReq->cb) psReq->cb(psDS248X, psReq) ;
+		else if (psReq->hTask) xTaskNotifyGive(psReq->hTask) ;
+	}
+}
+
+int	ds248xAsyncStart(ds248x_t * psDS248X) {
+	if (psDS248X->queue) return erSUCCESS ;
+	psDS248X->queue = xQueueCreate(ds248xASYNC_DEPTH, sizeof(ds248x_req_t *)) ;
+	if (psDS248X->queue == NULL) return erFAILURE ;
+	if (xTaskCreate(ds248xAsyncTask, "ds248x", ds248xASYNC_STACK, psDS248X, ds248xASYNC_PRIORITY, NULL) != pdPASS) {
+		SL_ERR("Dev=%d worker create failed", psDS248X->psI2C->DevIdx) ;
+		vQueueDelete(psDS248X->queue) ;
+		psDS248X->queue = NULL ;						// callers fall back to synchronous
+		return erFAILURE ;
+	}
+	return erSUCCESS ;
+}
+
+int	ds248xAsyncSubmit(ds248x_t * psDS248X, ds248x_req_t * psReq) {
+	IF_myASSERT(debugPARAM, psReq->Cmd < ds248xREQ_NUM && psReq->Chan < ds248xNUM_CHAN(psDS248X)) ;
+	if (psDS248X->queue == NULL) return erFAILURE ;
+	psReq->hTask	= (psReq->Flags & ds248xREQF_POST) ? NULL : xTaskGetCurrentTaskHandle() ;
+	psReq->iRV		= 0 ;
+	// PRIO is applied by ds248xAsyncPick(), queued at the front it would pass everything
+	return (xQueueSend(psDS248X->queue, &psReq, 0) == pdTRUE) ? erSUCCESS : erFAILURE ;
+}
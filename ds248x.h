@@ -6,6 +6,7 @@
 
 #include	"hal_config.h"
 #include	"hal_i2c.h"
+#include	"onewire_hist.h"
 
 #include	<stdint.h>
 
@@ -20,6 +21,69 @@ extern "C" {
 #define	d248xAUTO_LOCK_BUS			2					// un/locked on Bus select level
 #define	d248xAUTO_LOCK				d248xAUTO_LOCK_BUS
 
+#ifndef	ds248xBUILD_EMUL								// host build (test/) sets it on the command line
+	#define	ds248xBUILD_EMUL		0					// 1 = halI2C_Queue() answered by ds248x_emul.c
+#endif
+
+#define	ds248xWAIT_FIXED			0					// worst case owDELAY_* then read STAT
+#define	ds248xWAIT_ADAPTIVE			1					// learned delay then poll STAT until 1WB clear
+#define	ds248xWAIT_MODE				ds248xWAIT_ADAPTIVE
+
+#define	ds248xBUILD_WB_SPU			1					// WCFG(SPU) + 1WWB + read STAT as single I2C job
+
+#define	ds248xBUILD_ASYNC			1					// per device request queue & worker task
+#define	ds248xASYNC_DEPTH			16					// pending requests per device
+#define	ds248xASYNC_BYPASS			8					// max times a request is overtaken (DS2482-800)
+#define	ds248xASYNC_HOLD_MS			50					// max wait for a HOLD sequence's next request
+#define	ds248xASYNC_STACK			3072				// also runs platform scan/sample jobs
+#define	ds248xASYNC_PRIORITY		(tskIDLE_PRIORITY + 3)
+
+#define	ds248xBUILD_I2C_SPEED		1					// negotiate fastest clean I2C speed per device
+#define	ds248xI2C_1MHZ				1					// HAL has i2cSPEED_1000, tried on DS2484 only
+#define	ds248xI2C_PROBES			8					// clean register read backs required per speed
+
+#define	ds248xBUILD_TRACE			1					// binary transaction trace ring buffer
+#define	ds248xTRACE_SIZE			256					// records, power of 2
+
+/* Build time specialisation for products with a single bridge model and/or a fixed number of
+ * bridges, Type & channel count checks and device indexing then fold away at compile time */
+#define	ds248xTYPE_ANY				0					// detected at run time
+#define	ds248xTYPE_2482_10X			1
+#define	ds248xTYPE_2482_800			2
+#define	ds248xTYPE_2484				3
+#ifndef	ds248xBUILD_TYPE								// host build (test/) also builds a specialised variant
+	#define	ds248xBUILD_TYPE		ds248xTYPE_ANY
+#endif
+#ifndef	ds248xBUILD_COUNT
+	#define	ds248xBUILD_COUNT		0					// 0 = detected at run time, else fixed
+#endif
+
+#if		(ds248xBUILD_TYPE == ds248xTYPE_2482_10X)
+	#define	ds248xIS_TYPE(psDS248X, T)	((T) == i2cDEV_DS2482_10X)
+	#define	ds248xNUM_CHAN(psDS248X)	1
+#elif	(ds248xBUILD_TYPE == ds248xTYPE_2482_800)
+	#define	ds248xIS_TYPE(psDS248X, T)	((T) == i2cDEV_DS2482_800)
+	#define	ds248xNUM_CHAN(psDS248X)	8
+#elif	(ds248xBUILD_TYPE == ds248xTYPE_2484)
+	#define	ds248xIS_TYPE(psDS248X, T)	((T) == i2cDEV_DS2484)
+	#define	ds248xNUM_CHAN(psDS248X)	1
+#else
+	#define	ds248xIS_TYPE(psDS248X, T)	((psDS248X)->psI2C->Type == (T))
+	#define	ds248xNUM_CHAN(psDS248X)	((psDS248X)->NumChan)
+#endif
+
+#if		(ds248xBUILD_COUNT == 1)
+	#define	ds248xDEV(Num)				(psaDS248X)
+#else
+	#define	ds248xDEV(Num)				(&psaDS248X[Num])
+#endif
+#define	ds248xNUM_DEV				(ds248xBUILD_COUNT ? ds248xBUILD_COUNT : ds248xCount)
+
+#define	ds248xBUILD_PADJ_CAL		0					// 1 = calibrate DS2484 port timing during config
+#define	ds2484PADJ_DEFAULT			0x06				// VAL after device reset, all parameters
+#define	ds2484CAL_ROUNDS			4					// full bus enumerations per candidate value
+#define	ds2484CAL_MARGIN			1					// steps added above shortest working value
+
 // ################################### DS248X 1-Wire Commands ######################################
 
 #define ds248xCMD_DRST   			0xF0				// Device Reset (525nS)
@@ -60,6 +124,19 @@ extern "C" {
 #define	owDELAY_ST_OD				33					// (3 * 11) + 0.2625
 #define	owDELAY_SB_OD				11U					// 11 + 0.2625
 #endif
+
+// Adaptive wait, learned delay as fraction (x/128) of the nominal owDELAY_* value
+#define	ds248xPCT_INIT				128U				// start at nominal
+#define	ds248xPCT_MIN				48U					// never below 37.5% of nominal
+#define	ds248xPCT_MAX				192U				// never above 150% of nominal
+#define	ds248xPCT_GROW				6U					// per extra STAT poll required
+#define	ds248xPCT_SHRINK			1U					// per completion without STAT poll
+#define	ds248xPOLL_MAX				20					// STAT polls before 1WB stuck error
+
+// Error recovery, cheapest level first: retry -> re-select channel -> device reset
+// 1-Wire commands are not repeated, the reset/address/command transaction is
+#define	ds248xREC_RETRIES			2					// retries before escalating
+#define	ds248xREC_BACKOFF			1					// mS, doubled on every retry
 // ######################################## Enumerations ###########################################
 
 enum {													// DS248X register numbers
@@ -71,6 +148,78 @@ enum {													// DS248X register numbers
 	ds248xREG_NUM,
 } ;
 
+enum {													// DS2484 port adjust PARameter selector
+	ds2484PAR_TRSTL,									// reset low time
+	ds2484PAR_TMSP,										// presence detect sampling time
+	ds2484PAR_TW0L,										// write zero low time
+	ds2484PAR_TREC0,									// write zero recovery time
+	ds2484PAR_RWPU,										// weak pull-up resistor
+	ds2484PAR_NUM,
+} ;
+
+enum {													// 1-Wire operations with a bus delay
+	ds248xOP_RST,
+	ds248xOP_WB,
+	ds248xOP_RB,
+	ds248xOP_ST,
+	ds248xOP_SB,
+	ds248xOP_NUM,
+} ;
+
+enum {													// latency histograms per device
+	ds248xH_RST,										// 1-Wire reset
+	ds248xH_WB,											// write byte
+	ds248xH_RB,											// read byte
+	ds248xH_ST,											// triplet
+	ds248xH_SB,											// single bit
+	ds248xH_CHSL,										// channel select
+	ds248xH_WCFG,										// config write
+	ds248xH_REG,										// DRST, SRP & PADJ
+	ds248xH_NUM,
+} ;
+
+enum {													// asynchronous request commands
+	ds248xREQ_SELECT,									// channel select only
+	ds248xREQ_RESET,
+	ds248xREQ_WRITE,
+	ds248xREQ_READ,
+	ds248xREQ_TRIPLET,
+	ds248xREQ_BIT,
+	ds248xREQ_EXEC,										// run cb as job, selects/releases bus itself
+	ds248xREQ_SEARCH,									// complete ROM search, pvArg -> ds248x_srch_t
+	ds248xREQ_NUM,
+} ;
+
+enum {													// asynchronous request flags
+	ds248xREQF_HOLD		= (1 << 0),						// keep bus locked for same task's next request
+	ds248xREQF_PRIO		= (1 << 1),						// overtakes other tasks' requests for other channels
+	ds248xREQF_POST		= (1 << 2),						// no completion notification, submitter does not wait
+} ;
+
+enum {													// error classes
+	ds248xERR_I2C,										// I2C transaction failed, transient
+	ds248xERR_OWB,										// 1-Wire busy, line held low
+	ds248xERR_SD,										// short detected during reset
+	ds248xERR_CRC,										// 1-Wire data CRC failure
+	ds248xERR_RDBK,										// CONF/CHAN/PADJ read back mismatch
+	ds248xERR_NUM,
+} ;
+
+enum {													// recovery levels, increasing cost
+	ds248xREC_RETRY,									// back off & re-issue command
+	ds248xREC_RESEL,									// re-select channel & rewrite CONF
+	ds248xREC_RESET,									// device reset & full reconfigure
+	ds248xREC_FAIL,										// recovery exhausted
+	ds248xREC_NUM,
+} ;
+
+enum {													// CONFiguration register bitmap
+	ds248xCONF_APU		= (1 << 0),						// Active Pull Up
+	ds248xCONF_PDN		= (1 << 1),						// Pull Down (DS2484 only)
+	ds248xCONF_SPU		= (1 << 2),						// Strong Pull Up
+	ds248xCONF_1WS		= (1 << 3),						// 1-Wire Speed
+} ;
+
 enum {													// STATus register bitmap
 	ds248xSTAT_1WB		= (1 << 0),						// 1W Busy
 	ds248xSTAT_PPD		= (1 << 1),						// Presence Pulse Detected
@@ -116,6 +265,7 @@ typedef struct __attribute__((packed)) ds248x_t {		// DS248X I2C <> 1Wire bridge
 	i2c_di_t *			psI2C ;							// size = 4
 	SemaphoreHandle_t	mux ;
 	TimerHandle_t		tmr ;
+	QueueHandle_t		queue ;							// asynchronous requests
 	union {												// size = 5
 		struct __attribute__((packed)) {
 			union {
@@ -156,15 +306,91 @@ typedef struct __attribute__((packed)) ds248x_t {		// DS248X I2C <> 1Wire bridge
 	} ;
 	uint8_t				CurChan	: 3 ;					// 0 -> 7
 	uint8_t				Rptr	: 3 ;					// 0 -> 4
-	uint8_t				Spare	: 2 ;
+	uint8_t				Poll	: 1 ;					// polling STAT, 1WB expected
+	uint8_t				PostRst	: 1 ;					// last 1-Wire operation was reset with presence
 	// Static info
 	uint8_t				I2Cnum	: 4 ;					// index into I2C Device Info table
 	uint8_t				NumChan	: 4 ;					// 0 / 1 / 8
 	uint8_t				Lo		: 4 ;
 	uint8_t				Hi		: 4 ;
 	uint8_t				PrvStat[8] ;					// previous STAT reg
+	uint8_t				Pct[8][ds248xOP_NUM] ;			// learned delay per channel & operation
+	uint8_t				Padj[ds2484PAR_NUM] ;			// DS2484 standard speed VAL, restored on ReConfig
+	// Shadow state, hardware known to match Rconf / Rptr / CurChan
+	uint8_t				ShdConf	: 1 ;					// Rconf == CONF register
+	uint8_t				ShdRptr	: 1 ;					// Rptr == read pointer
+	uint8_t				SpuOn	: 1 ;					// strong pullup active (SPU already clear in Rconf), ends at next 1-Wire cmd
+	uint8_t				ErrCls	: 3 ;					// ds248xERR_* of last failure
+	uint8_t				InRec	: 1 ;					// recovery in progress, no nesting
+	uint8_t				OWErr	: 1 ;					// 1-Wire primitive failed since last reset
+	uint16_t			NoWCFG ;						// suppressed (redundant) transactions
+	uint16_t			NoSRP ;
+	uint16_t			NoCHSL ;
+	uint16_t			ReOrder ;						// async requests run ahead to stay on CurChan
+	uint16_t			ChslFifo ;						// CHSL submission order would have needed
+	uint16_t			ChslDone ;						// CHSL actually needed by the worker
+	uint8_t				SpeedMax ;						// negotiated i2cSPEED_*
+	uint8_t				SpeedDown ;						// step downs after errors
+	uint16_t			Err[ds248xERR_NUM] ;			// errors per class
+	uint16_t			Rec[ds248xREC_NUM] ;			// recovery actions per level
+	owhist_t *			psHist ;						// [ds248xH_NUM], separately allocated (aligned)
 } ds248x_t ;
-DUMB_STATIC_ASSERT(sizeof(ds248x_t) == 28) ;
+DUMB_STATIC_ASSERT(sizeof(ds248x_t) == 114) ;
+
+/* One I2C transaction as issued at ds248xI2C_Read() / ds248xI2C_WriteDelayRead().
+ * Export format: ds248x_trace_hdr_t then Count records oldest first, little endian */
+typedef struct __attribute__((packed)) ds248x_trace_t {
+	uint32_t			Time ;							// uS at start
+	uint16_t			Delay ;							// uS requested between write & read
+	uint8_t				Dev		: 4 ;					// I2C device index
+	uint8_t				Chan	: 3 ;					// current channel
+	uint8_t				OK		: 1 ;					// I2C transaction succeeded
+	uint8_t				Tx[4] ;							// bytes written, Tx[0] 0 if read only
+	uint8_t				Rx ;							// register byte returned
+	uint8_t				Rptr	: 3 ;					// register read
+	uint8_t				TxLen	: 3 ;					// 0 -> 4 bytes written
+	uint8_t				Spare	: 2 ;
+} ds248x_trace_t ;
+DUMB_STATIC_ASSERT(sizeof(ds248x_trace_t) == 13) ;
+
+typedef struct __attribute__((packed)) ds248x_trace_hdr_t {
+	uint8_t				Magic[2] ;						// 'D' 'T'
+	uint8_t				Version ;						// 2
+	uint8_t				RecSize ;						// sizeof(ds248x_trace_t)
+	uint32_t			Count ;							// records following
+} ds248x_trace_hdr_t ;
+
+/* Complete ROM search state, carried from one ds248xOWSearch() call to the next.
+ * LD/LFD/LDF as in Maxim AN187, ROM in 1-Wire (LSB first) byte order */
+typedef struct ds248x_srch_t {
+	uint8_t				ROM[8] ;						// in: previous ROM, out: ROM found
+	uint8_t				Cmd ;							// OW_CMD_SEARCHROM or OW_CMD_SEARCHALARM
+	uint8_t				LD ;							// last discrepancy
+	uint8_t				LFD ;							// last family discrepancy
+	uint8_t				LDF ;							// last device flag
+	uint8_t				Bits ;							// out: triplets completed, 64 if ROM read
+	uint8_t				Crc ;							// out: CRC8 of ROM, 0 if valid
+} ds248x_srch_t ;
+
+typedef struct ds248x_req_t ds248x_req_t ;
+typedef void (* ds248x_cb_t)(ds248x_t *, ds248x_req_t *) ;
+
+/* Asynchronous 1-Wire request, owned by the caller until completed.
+ * On completion the callback (if any) is executed in the device worker context,
+ * else the submitting task is notified (ulTaskNotifyTake)
+ * ds248xREQ_EXEC runs the callback as the job itself then always notifies */
+struct ds248x_req_t {
+	ds248x_cb_t			cb ;
+	void *				pvArg ;
+	TaskHandle_t		hTask ;							// submitting task, set by ds248xAsyncSubmit()
+	uint8_t				Cmd ;							// ds248xREQ_*
+	uint8_t				Chan ;							// physical channel 0 -> 7
+	uint8_t				Data ;							// byte to write, direction or bit
+	uint8_t				Flags ;							// ds248xREQF_*
+	uint8_t				Rstat ;							// STAT after completion
+	uint8_t				Rdata ;							// byte/bit read, presence or STAT (triplet)
+	int8_t				iRV ;							// 1 = success, 0 = failed
+} ;
 
 // #################################### Public Data structures #####################################
 
@@ -174,12 +400,27 @@ DUMB_STATIC_ASSERT(sizeof(ds248x_t) == 28) ;
 
 // ############################## DS248X-x00 CORE support functions ################################
 
+/**
+ * Count an error of class eErr (ds248xERR_*) and apply the cheapest recovery level not yet
+ * used for this operation, Try is 0 on the first failure and incremented per re-issue.
+ * Returns 1 if the operation can be re-issued, 0 if recovery is exhausted
+ */
+int		ds248xRecover(ds248x_t * psDS248X, int eErr, int Try) ;
+
 
 // ###################################### Device debug support #####################################
 
 int32_t	ds248xReportRegister(ds248x_t * psDS248X, int Reg, bool Refresh) ;
 void	ds248xReport(ds248x_t * psDS248X, bool Refresh) ;
 void	ds248xReportAll(bool Refresh) ;
+void	ds248xReportHist(ds248x_t * psDS248X, bool Reset) ;
+void	ds248xTraceEnable(bool Enable) ;
+/**
+ * Copy the trace (oldest first) with header into pBuf, returns bytes used.
+ * Records are not locked, disable tracing first for an exact snapshot
+ */
+size_t	ds248xTraceExport(uint8_t * pBuf, size_t Size) ;
+void	ds248xTraceReport(int Count) ;
 
 // ############################### Identify, test and configure ####################################
 
@@ -193,6 +434,11 @@ int32_t	ds248xIdentify(i2c_di_t * psI2C_DI) ;
  */
 int32_t	ds248xConfig(i2c_di_t * psI2C_DI) ;
 void	ds248xReConfig(i2c_di_t * psI2C_DI) ;
+/**
+ * Step I2C speed up from 100KHz to the device maximum (400KHz DS2482, 1MHz DS2484) while
+ * register read back remains clean. Returns the speed (i2cSPEED_*) selected
+ */
+int		ds248xSpeedNegotiate(ds248x_t * psDS248X) ;
 
 // ############################## DS248X-x00 1-Wire support functions ##############################
 
@@ -210,11 +456,18 @@ int		ds248xOWSpeed(ds248x_t * psDS248X, bool speed) ;
  * 'new_level' - new level defined as
  *					 MODE_STANDARD	  0x00
  *
+ * An active strong pull-up is left to the bridge, it ends (and clears CONF SPU) at the start
+ * of the next 1-Wire command, only an armed but unused SPU is cleared with WCFG.
+ *
  * Returns:  current 1-Wire Net level
  */
 int		ds248xOWLevel(ds248x_t * psDS248X, bool level) ;
 uint8_t ds248xOWTouchBit(ds248x_t * psDS248X, uint8_t sendbit) ;
 void	ds248xOWWriteByte(ds248x_t * psDS248X, uint8_t sendbyte) ;
+/**
+ * Write a byte with the strong pull-up enabled as soon as the byte completes, WCFG(SPU) and
+ * 1WWB issued as one I2C job. Returns 1 if the strong pull-up is active else 0
+ */
 int		ds248xOWWriteBytePower(ds248x_t * psDS248X, uint8_t sendbyte) ;
 uint8_t	ds248xOWReadByte(ds248x_t * psDS248X) ;
 /**
@@ -226,6 +479,36 @@ uint8_t	ds248xOWReadByte(ds248x_t * psDS248X) ;
  * Returns � The DS248x status byte result from the triplet command
  */
 uint8_t ds248xOWSearchTriplet(ds248x_t * psDS248X, uint8_t search_direction) ;
+/**
+ * Reset, search command and all 64 triplets of one ROM search in a single call, directions
+ * taken from the LD state in psS. Runs directly or as a ds248xREQ_SEARCH async job.
+ * Returns 1 if a ROM with valid CRC was found, else 0 with the search state reset
+ */
+int		ds248xOWSearch(ds248x_t * psDS248X, ds248x_srch_t * psS) ;
+
+// ################################ DS2484 1-Wire port adjustment ##################################
+
+/**
+ * Program one DS2484 port parameter, verified by read back if OD matches current speed
+ * Returns 1 if written (and verified) else 0
+ */
+int		ds248xPortAdjust(ds248x_t * psDS248X, uint8_t Par, bool OD, uint8_t Val) ;
+/**
+ * Find the shortest standard speed tRSTL, tW0L & tREC0 values at which the attached
+ * devices still enumerate without presence or CRC errors, then add ds2484CAL_MARGIN.
+ * Returns erSUCCESS if calibrated, erFAILURE if not a DS2484 or no devices found
+ */
+int		ds248xPortCalibrate(ds248x_t * psDS248X) ;
+
+// ############################## DS248X asynchronous request support ##############################
+
+int		ds248xAsyncStart(ds248x_t * psDS248X) ;
+/**
+ * Queue a 1-Wire request for the device worker, the calling task does not block.
+ * Timer callbacks must only post (ds248xREQF_POST) EXEC jobs, never do I2C work themselves.
+ * Returns erSUCCESS if queued, erFAILURE if queue full or worker not running
+ */
+int		ds248xAsyncSubmit(ds248x_t * psDS248X, ds248x_req_t * psReq) ;
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,699 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * ds248x_emul.c - DS248x bridge & 1-Wire bus emulator
+ */
+
+#include	"hal_variables.h"
+#include	"onewire_platform.h"
+#include	"ds248x_emul.h"
+#include	"printfx.h"
+#include	"syslog.h"
+#include	"x_errors_events.h"
+
+#include	<string.h>
+
+#if		(ds248xBUILD_EMUL > 0)
+
+#define	debugFLAG					0xF000
+
+#define	debugTIMING					(debugFLAG_GLOBAL & debugFLAG & 0x1000)
+#define	debugTRACK					(debugFLAG_GLOBAL & debugFLAG & 0x2000)
+#define	debugPARAM					(debugFLAG_GLOBAL & debugFLAG & 0x4000)
+#define	debugRESULT					(debugFLAG_GLOBAL & debugFLAG & 0x8000)
+
+// ###################################### General macros ###########################################
+
+// Typical (not worst case) 1-Wire timing in nS, DS2482 datasheet
+#define	emulT_RSTL					560000U
+#define	emulT_RSTH					560000U
+#define	emulT_SLOT					69000U
+#define	emulT_RSTL_OD				68000U
+#define	emulT_RSTH_OD				64000U
+#define	emulT_SLOT_OD				10500U
+
+#define	emulT_CONV_10				750000U				// uS, DS18S20 fixed 750mS
+#define	emulT_CONV_28				93750U				// uS, DS18B20 9 bit, doubles per bit
+
+// ######################################## Enumerations ###########################################
+
+enum { emulOW_IDLE, emulOW_ROMCMD, emulOW_MATCH, emulOW_READROM, emulOW_SEARCH,
+		emulOW_FUNC, emulOW_RDSP, emulOW_WRSP, emulOW_PSU, emulOW_CONV } ;
+
+// ######################################### Structures ############################################
+
+typedef struct emul_owdev_t {							// virtual 1-Wire device
+	ow_rom_t	ROM ;
+	uint8_t		SP[9] ;									// scratchpad
+	uint8_t		EE[3] ;									// Thi, Tlo, Conf
+	uint64_t	tDone ;									// conversion complete time
+	uint8_t		Pwr		: 1 ;							// 0=parasitic 1=external
+	uint8_t		Sel		: 1 ;							// participating/selected
+	uint8_t		ODcap	: 1 ;							// supports Overdrive Skip/Match ROM
+	uint8_t		OD		: 1 ;							// switched to overdrive
+	uint8_t		RCcap	: 1 ;							// supports Resume ROM
+	uint8_t		RC		: 1 ;							// selected by last Match ROM
+	uint8_t		Therm	: 1 ;							// DS18x20 scratchpad & conversion
+	uint8_t		Res		: 1 ;							// DS18B20 CONF byte & resolution
+} emul_owdev_t ;
+
+typedef struct emul_chan_t {							// virtual 1-Wire bus
+	emul_owdev_t	Dev[ds248xEMUL_MAXOWDEV] ;
+	uint8_t			NumDev ;
+	uint8_t			State ;
+	uint8_t			Count ;								// byte/bit counter within State
+	uint8_t			ODonly ;							// bus at overdrive, standard devices ignore
+	uint8_t			Match[sizeof(ow_rom_t)] ;
+} emul_chan_t ;
+
+typedef struct emul_bridge_t {							// virtual DS248x
+	i2c_di_t		sI2C ;
+	emul_chan_t		Chan[ds248xEMUL_MAXCHAN] ;
+	uint64_t		tBusy ;								// 1-Wire busy until
+	uint64_t		tBus ;								// accumulated bus time (I2C + 1-Wire)
+	uint32_t		Trans ;								// I2C transactions
+	uint32_t		Bytes ;								// I2C bytes transferred
+	uint32_t		Nack ;
+	uint8_t			Type ;
+	uint8_t			Rptr ;
+	uint8_t			Stat ;
+	uint8_t			Data ;								// DATA register, updated once 1WRB completes
+	uint8_t			Data1W ;							// byte read by the last 1WRB
+	uint8_t			Conf ;
+	uint8_t			CurChan ;
+	uint8_t			Padj[5][2] ;						// [PAR][OD] VAL, tREC0 & RWPU same for both
+	uint8_t			PadjIdx ;
+	uint8_t			SpuOn ;								// strong pullup active after last cmd
+	uint32_t		Spu ;								// strong pullups started
+	uint8_t			Slow ;								// fault: 1-Wire commands take Slow % longer
+	uint8_t			FailCmd ;							// fault: NACK transactions starting with FailCmd
+	uint8_t			FailCount ;
+	uint8_t			FailDone ;							// NACK after the commands executed
+} emul_bridge_t ;
+
+// ###################################### Local variables ##########################################
+
+static emul_bridge_t	saEmul[ds248xEMUL_MAXBRIDGE] = { 0 } ;
+static uint8_t			EmulCount = 0 ;
+static uint64_t			EmulNow = 0 ;					// virtual clock in uS
+
+// DS2482-800 CHAN register read back codes, channel 0 -> 7
+static const uint8_t emulV2N[8] = { 0xB8, 0xB1, 0xAA, 0xA3, 0x9C, 0x95, 0x8E, 0x87 } ;
+
+// ################################ Local ONLY utility functions ###################################
+
+static uint8_t ds248xEmulCRC8(uint8_t * pBuf, int Len) {
+	uint8_t crc8 = 0 ;
+	while (Len--) {
+		crc8 ^= *pBuf++ ;
+		for (int i = 0; i < 8; ++i) crc8 = (crc8 & 1) ? (crc8 >> 1) ^ 0x8C : (crc8 >> 1) ;
+	}
+	return crc8 ;
+}
+
+static emul_bridge_t * ds248xEmulBridge(i2c_di_t * psI2C) {
+	emul_bridge_t * psEB = (emul_bridge_t *) ((uint8_t *) psI2C - offsetof(emul_bridge_t, sI2C)) ;
+	IF_myASSERT(debugPARAM, psEB >= &saEmul[0] && psEB < &saEmul[EmulCount]) ;
+	return psEB ;
+}
+
+static bool ds248xEmulCheckCode(uint8_t Code) { return ((Code >> 4) ^ 0x0F) == (Code & 0x0F) ; }
+
+// DS2484 PADJ standard speed timing, 1-Wire spec requires tRSTL >= 480uS & tW0L >= 60uS
+static const uint8_t emulTrstl[16]	= { 44, 46, 48, 50, 52, 54, 56, 58, 60, 62, 64, 66, 68, 70, 72, 74 } ;
+static const uint8_t emulTwol0[16]	= { 52, 54, 56, 58, 60, 62, 64, 66, 68, 70, 70, 70, 70, 70, 70, 70 } ;
+static const uint16_t emulTrec0[16]	= { 275, 275, 275, 275, 275, 275, 525, 775, 1025, 1275, 1525, 1775, 2025, 2275, 2525, 2525 } ;
+
+static bool ds248xEmulPadjStd(emul_bridge_t * psEB) { return psEB->Type == i2cDEV_DS2484 && (psEB->Conf & 0x08) == 0 ; }
+
+static bool ds248xEmulShortRSTL(emul_bridge_t * psEB) {
+	return ds248xEmulPadjStd(psEB) && emulTrstl[psEB->Padj[0][0]] < 48 ;
+}
+
+static bool ds248xEmulShortW0L(emul_bridge_t * psEB) {
+	return ds248xEmulPadjStd(psEB) && emulTwol0[psEB->Padj[2][0]] < 60 ;
+}
+
+static uint32_t ds248xEmulSlotNS(emul_bridge_t * psEB) {
+	if (ds248xEmulPadjStd(psEB))						// tW0L + tREC0 from PADJ
+		return (emulTwol0[psEB->Padj[2][0]] * 1000U) + (emulTrec0[psEB->Padj[3][0]] * 10U) ;
+	return (psEB->Conf & 0x08) ? emulT_SLOT_OD : emulT_SLOT ;
+}
+
+static uint32_t ds248xEmulResetNS(emul_bridge_t * psEB) {
+	if (ds248xEmulPadjStd(psEB))
+		return emulTrstl[psEB->Padj[0][0]] * 10000U * 2 ;	// tRSTL + tRSTH
+	return (psEB->Conf & 0x08) ? (emulT_RSTL_OD + emulT_RSTH_OD) : (emulT_RSTL + emulT_RSTH) ;
+}
+
+/**
+ * @brief	charge the virtual clock with the I2C bit time of a transaction
+ *	S AD [A] Tx...[A] (Sr AD [A] Rx...[A]) P
+ */
+static void ds248xEmulChargeI2C(emul_bridge_t * psEB, size_t TxSize, size_t RxSize) {
+	uint32_t Hz = (psEB->sI2C.Speed == i2cSPEED_1000) ? 1000000U
+				: (psEB->sI2C.Speed == i2cSPEED_400) ? 400000U : 100000U ;
+	uint32_t Bits = 2 + (TxSize ? 9 * (1 + TxSize) : 0) + (RxSize ? 1 + 9 * (1 + RxSize) : 0) ;
+	uint32_t uS = (Bits * 1000000U) / Hz ;
+	EmulNow	+= uS ;
+	psEB->tBus += uS ;
+	psEB->Trans++ ;
+	psEB->Bytes += TxSize + RxSize ;
+}
+
+static void ds248xEmulStart1W(emul_bridge_t * psEB, uint32_t nS) {
+	if (psEB->SpuOn) {									// next 1-Wire command ends strong pullup
+		psEB->SpuOn = 0 ;
+		psEB->Conf &= ~0x04 ;
+	}
+	nS += (nS / 100U) * psEB->Slow ;
+	psEB->tBusy = EmulNow + ((nS + 999U) / 1000U) ;
+	psEB->tBus += (nS + 999U) / 1000U ;
+	psEB->Stat &= ~(ds248xSTAT_RST | ds248xSTAT_SD) ;
+}
+
+// ################################### Virtual 1-Wire devices ######################################
+
+static void ds248xEmulConvert(emul_owdev_t * psOD) {
+	uint32_t tConv = psOD->Res ? (emulT_CONV_28 << ((psOD->SP[4] >> 5) & 0x03)) : emulT_CONV_10 ;
+	psOD->tDone = EmulNow + tConv ;
+}
+
+static void ds248xEmulUpdateCRC(emul_owdev_t * psOD) { psOD->SP[8] = ds248xEmulCRC8(psOD->SP, 8) ; }
+
+static void ds248xEmulFunction(emul_chan_t * psEC, uint8_t Byte) {
+	psEC->Count = 0 ;
+	switch (Byte) {
+	case DS18X20_CONVERT:
+		for (int i = 0; i < psEC->NumDev; ++i) if (psEC->Dev[i].Sel) ds248xEmulConvert(&psEC->Dev[i]) ;
+		psEC->State = emulOW_CONV ;
+		break ;
+	case DS18X20_READ_SP:	psEC->State = emulOW_RDSP ;	break ;
+	case DS18X20_WRITE_SP:	psEC->State = emulOW_WRSP ;	break ;
+	case DS18X20_READ_PSU:	psEC->State = emulOW_PSU ;	break ;
+	case DS18X20_COPY_SP:
+	case DS18X20_RECALL_EE:
+		for (int i = 0; i < psEC->NumDev; ++i) {
+			emul_owdev_t * psOD = &psEC->Dev[i] ;
+			if (psOD->Sel == 0 || psOD->Therm == 0) continue ;
+			if (Byte == DS18X20_COPY_SP) memcpy(psOD->EE, &psOD->SP[2], psOD->Res ? 3 : 2) ;
+			else memcpy(&psOD->SP[2], psOD->EE, psOD->Res ? 3 : 2) ;
+			ds248xEmulUpdateCRC(psOD) ;
+		}
+		psEC->State = emulOW_IDLE ;
+		break ;
+	default:				psEC->State = emulOW_IDLE ;	break ;
+	}
+}
+
+static void ds248xEmulWriteByte(emul_chan_t * psEC, uint8_t Byte) {
+	switch (psEC->State) {
+	case emulOW_ROMCMD:
+		psEC->Count = 0 ;
+		bool ODcmd = (Byte == OW_CMD_ODSKIPROM || Byte == OW_CMD_ODMATCHROM) ;
+		for (int i = 0; i < psEC->NumDev; ++i) {		// after overdrive reset only OD devices listen
+			emul_owdev_t * psOD = &psEC->Dev[i] ;
+			if (Byte == OW_CMD_ODSKIPROM && psEC->ODonly == 0) psOD->OD = psOD->ODcap ;
+			psOD->Sel = psEC->ODonly ? psOD->OD : ODcmd ? psOD->ODcap : 1 ;
+			if (Byte == OW_CMD_RESUME) psOD->Sel = psOD->Sel && psOD->RC ;
+			else psOD->RC = 0 ;							// set again by a completed Match ROM
+		}
+		if (ODcmd) psEC->ODonly = 1 ;
+		switch (Byte) {
+		case OW_CMD_SEARCHROM:
+		case OW_CMD_SEARCHALARM:
+			if (Byte == OW_CMD_SEARCHALARM) {			// only devices outside Tlo/Thi
+				for (int i = 0; i < psEC->NumDev; ++i) {
+					emul_owdev_t * psOD = &psEC->Dev[i] ;
+					int16_t Traw = (psOD->SP[1] << 8) | psOD->SP[0] ;
+					int8_t T = psOD->Res ? (Traw >> 4) : (Traw >> 1) ;
+					psOD->Sel = psOD->Therm && (T > (int8_t) psOD->SP[2] || T < (int8_t) psOD->SP[3]) ;
+				}
+			}
+			psEC->State = emulOW_SEARCH ;	break ;
+		case OW_CMD_MATCHROM:
+		case OW_CMD_ODMATCHROM:	psEC->State = emulOW_MATCH ;	break ;
+		case OW_CMD_SKIPROM:
+		case OW_CMD_ODSKIPROM:
+		case OW_CMD_RESUME:		psEC->State = emulOW_FUNC ;		break ;
+		case OW_CMD_READROM:	psEC->State = emulOW_READROM ;	break ;
+		default:				psEC->State = emulOW_IDLE ;		break ;
+		}
+		break ;
+	case emulOW_MATCH:
+		psEC->Match[psEC->Count++] = Byte ;
+		if (psEC->Count == sizeof(ow_rom_t)) {
+			for (int i = 0; i < psEC->NumDev; ++i) {
+				emul_owdev_t * psOD = &psEC->Dev[i] ;
+				psOD->Sel = psOD->Sel && memcmp(psOD->ROM.HexChars, psEC->Match, sizeof(ow_rom_t)) == 0 ;
+				psOD->RC = psOD->Sel && psOD->RCcap ;
+				if (psEC->ODonly) psOD->OD |= psOD->Sel ;	// Overdrive Match ROM, matched device only
+			}
+			psEC->State = emulOW_FUNC ;
+		}
+		break ;
+	case emulOW_FUNC:
+		ds248xEmulFunction(psEC, Byte) ;
+		break ;
+	case emulOW_WRSP:
+		for (int i = 0; i < psEC->NumDev; ++i) {
+			emul_owdev_t * psOD = &psEC->Dev[i] ;
+			if (psOD->Sel == 0) continue ;
+			if (psEC->Count < 2 || (psEC->Count == 2 && psOD->Res)) {
+				psOD->SP[2 + psEC->Count] = Byte ;
+				ds248xEmulUpdateCRC(psOD) ;
+			}
+		}
+		++psEC->Count ;
+		break ;
+	default:
+		psEC->State = emulOW_IDLE ;
+		break ;
+	}
+}
+
+static uint8_t ds248xEmulReadByte(emul_chan_t * psEC) {
+	uint8_t Byte = 0xFF ;								// wired AND of all selected devices
+	for (int i = 0; i < psEC->NumDev; ++i) {
+		emul_owdev_t * psOD = &psEC->Dev[i] ;
+		if (psOD->Sel == 0) continue ;
+		if (psEC->State == emulOW_READROM && psEC->Count < sizeof(ow_rom_t)) {
+			Byte &= psOD->ROM.HexChars[psEC->Count] ;
+		} else if (psEC->State == emulOW_RDSP && psEC->Count < sizeof(psOD->SP) && psOD->Therm) {
+			Byte &= psOD->SP[psEC->Count] ;
+		}
+	}
+	++psEC->Count ;
+	return Byte ;
+}
+
+static uint8_t ds248xEmulTouchBit(emul_chan_t * psEC, uint8_t Bit) {
+	if (Bit == 0) return 0 ;							// write 0 slot, nothing to read
+	uint8_t Res = 1 ;
+	for (int i = 0; i < psEC->NumDev; ++i) {
+		emul_owdev_t * psOD = &psEC->Dev[i] ;
+		if (psOD->Sel == 0) continue ;
+		if (psEC->State == emulOW_PSU && psOD->Pwr == 0) Res = 0 ;
+		if (psEC->State == emulOW_CONV && EmulNow < psOD->tDone) Res = 0 ;
+	}
+	return Res ;
+}
+
+static uint8_t ds248xEmulTriplet(emul_chan_t * psEC, uint8_t Dir) {
+	if (psEC->State != emulOW_SEARCH) return ds248xSTAT_SBR | ds248xSTAT_TSB | ds248xSTAT_DIR ;
+	uint8_t Byte = psEC->Count / 8, Mask = 1 << (psEC->Count % 8) ;
+	uint8_t IdBit = 1, CmpBit = 1 ;
+	for (int i = 0; i < psEC->NumDev; ++i) {
+		if (psEC->Dev[i].Sel == 0) continue ;
+		if (psEC->Dev[i].ROM.HexChars[Byte] & Mask)	CmpBit = 0 ;
+		else										IdBit = 0 ;
+	}
+	if (IdBit != CmpBit) Dir = IdBit ;					// all remaining devices agree
+	else if (IdBit) Dir = 1 ;							// no devices left
+	for (int i = 0; i < psEC->NumDev; ++i) {
+		if (((psEC->Dev[i].ROM.HexChars[Byte] & Mask) ? 1 : 0) != Dir) psEC->Dev[i].Sel = 0 ;
+	}
+	if (++psEC->Count == 64) psEC->State = emulOW_FUNC ;
+	return (IdBit ? ds248xSTAT_SBR : 0) | (CmpBit ? ds248xSTAT_TSB : 0) | (Dir ? ds248xSTAT_DIR : 0) ;
+}
+
+// ################################### Virtual DS248x bridges ######################################
+
+static void ds248xEmulDeviceReset(emul_bridge_t * psEB) {
+	psEB->Stat		= ds248xSTAT_RST | ds248xSTAT_LL ;
+	psEB->Conf		= 0 ;
+	psEB->CurChan	= 0 ;
+	psEB->Rptr		= ds248xREG_STAT ;
+	psEB->SpuOn		= 0 ;
+	psEB->PadjIdx	= 0 ;
+	// PAR=000..100 OD=0 VAL=0110 ie datasheet defaults
+	for (int i = 0; i < 5; ++i) psEB->Padj[i][0] = psEB->Padj[i][1] = 0x06 ;
+}
+
+/**
+ * @brief	process one command (and parameter) from the I2C write buffer
+ * @return	number of bytes consumed, 0 if command NACK'ed
+ */
+static int ds248xEmulCommand(emul_bridge_t * psEB, uint8_t * pBuf, size_t Size) {
+	uint8_t Cmd = pBuf[0] ;
+	uint8_t Par = (Size > 1) ? pBuf[1] : 0 ;
+	bool	Busy = (EmulNow < psEB->tBusy) ;
+	emul_chan_t * psEC = &psEB->Chan[psEB->CurChan] ;
+	switch (Cmd) {
+	case ds248xCMD_DRST:
+		ds248xEmulDeviceReset(psEB) ;
+		return 1 ;
+
+	case ds248xCMD_SRP:
+		if (Size < 2 || ds248xEmulCheckCode(Par) == 0) return 0 ;
+		Par &= 0x0F ;
+		if ((Par >= ds248xREG_NUM)
+		|| (Par == ds248xREG_CHAN && psEB->Type != i2cDEV_DS2482_800)
+		|| (Par == ds248xREG_PADJ && psEB->Type != i2cDEV_DS2484)) return 0 ;
+		psEB->Rptr = Par ;
+		if (Par == ds248xREG_PADJ) psEB->PadjIdx = 0 ;
+		return 2 ;
+
+	case ds248xCMD_WCFG:
+		if (Size < 2 || Busy || ds248xEmulCheckCode(Par) == 0) return 0 ;
+		psEB->Conf	= Par & 0x0F ;
+		psEB->SpuOn	= 0 ;
+		psEB->Stat	&= ~ds248xSTAT_RST ;
+		psEB->Rptr	= ds248xREG_CONF ;
+		return 2 ;
+
+	case ds2482CMD_CHSL:								// also ds2484CMD_PADJ
+		if (Size < 2 || Busy) return 0 ;
+		if (psEB->Type == i2cDEV_DS2482_800) {
+			if (ds248xEmulCheckCode(Par) == 0 || (Par & 0x0F) > 7) return 0 ;
+			psEB->CurChan	= Par & 0x07 ;
+			psEB->Rptr		= ds248xREG_CHAN ;
+		} else if (psEB->Type == i2cDEV_DS2484) {
+			uint8_t Idx		= (Par >> 5 < 5) ? Par >> 5 : 4 ;
+			psEB->Padj[Idx][(Par >> 4) & 1] = Par & 0x0F ;
+			if (Idx >= 3) psEB->Padj[Idx][0] = psEB->Padj[Idx][1] = Par & 0x0F ;	// no OD value
+			psEB->Rptr		= ds248xREG_PADJ ;
+			psEB->PadjIdx	= 0 ;
+		} else return 0 ;
+		return 2 ;
+
+	case ds248xCMD_1WRS:
+		if (Busy) return 0 ;
+		ds248xEmulStart1W(psEB, ds248xEmulResetNS(psEB)) ;
+		for (int i = 0; i < psEC->NumDev; ++i) psEC->Dev[i].Sel = 0 ;
+		if (ds248xEmulShortRSTL(psEB)) {				// devices do not see a reset
+			psEC->State = emulOW_IDLE ;
+			psEB->Stat &= ~ds248xSTAT_PPD ;
+		} else {
+			int Present = 0 ;
+			psEC->ODonly = (psEB->Conf & 0x08) ? 1 : 0 ;
+			for (int i = 0; i < psEC->NumDev; ++i) {	// standard reset ends overdrive
+				if (psEC->ODonly == 0) psEC->Dev[i].OD = 0 ;
+				if (psEC->ODonly == 0 || psEC->Dev[i].OD) ++Present ;
+			}
+			psEC->State = emulOW_ROMCMD ;
+			psEB->Stat = (psEB->Stat & ~ds248xSTAT_PPD) | (Present ? ds248xSTAT_PPD : 0) ;
+		}
+		psEB->Rptr = ds248xREG_STAT ;
+		return 1 ;
+
+	case ds248xCMD_1WWB:
+		if (Size < 2 || Busy) return 0 ;
+		ds248xEmulStart1W(psEB, 8 * ds248xEmulSlotNS(psEB)) ;
+		if (psEB->Conf & 0x04) psEB->Spu += psEB->SpuOn = 1 ;
+		ds248xEmulWriteByte(psEC, ds248xEmulShortW0L(psEB) ? 0xFF : Par) ;	// 0 bits seen as 1
+		psEB->Rptr = ds248xREG_STAT ;
+		return 2 ;
+
+	case ds248xCMD_1WRB:
+		if (Busy) return 0 ;
+		ds248xEmulStart1W(psEB, 8 * ds248xEmulSlotNS(psEB)) ;
+		psEB->Data1W = ds248xEmulReadByte(psEC) ;
+		psEB->Rptr = ds248xREG_STAT ;
+		return 1 ;
+
+	case ds248xCMD_1WSB:
+		if (Size < 2 || Busy) return 0 ;
+		ds248xEmulStart1W(psEB, ds248xEmulSlotNS(psEB)) ;
+		if (psEB->Conf & 0x04) psEB->Spu += psEB->SpuOn = 1 ;
+		psEB->Stat = (psEB->Stat & ~ds248xSTAT_SBR) | (ds248xEmulTouchBit(psEC, ds248xEmulShortW0L(psEB) ? 1 : Par >> 7) ? ds248xSTAT_SBR : 0) ;
+		psEB->Rptr = ds248xREG_STAT ;
+		return 2 ;
+
+	case ds248xCMD_1WT:
+		if (Size < 2 || Busy) return 0 ;
+		ds248xEmulStart1W(psEB, 3 * ds248xEmulSlotNS(psEB)) ;
+		psEB->Stat = (psEB->Stat & ~(ds248xSTAT_SBR|ds248xSTAT_TSB|ds248xSTAT_DIR)) | ds248xEmulTriplet(psEC, ds248xEmulShortW0L(psEB) ? 1 : Par >> 7) ;
+		psEB->Rptr = ds248xREG_STAT ;
+		return 2 ;
+	}
+	return 0 ;
+}
+
+static uint8_t ds248xEmulReadRegister(emul_bridge_t * psEB) {
+	switch (psEB->Rptr) {
+	case ds248xREG_STAT:
+		return (EmulNow < psEB->tBusy) ? (psEB->Stat | ds248xSTAT_1WB) : psEB->Stat ;
+	case ds248xREG_DATA:								// previous byte until 1WRB completes
+		if (EmulNow >= psEB->tBusy) psEB->Data = psEB->Data1W ;
+		return psEB->Data ;
+	case ds248xREG_CHAN:	return emulV2N[psEB->CurChan] ;
+	case ds248xREG_CONF:	return psEB->Conf ;			// upper nibble always read as 0
+	case ds248xREG_PADJ: {								// values for the current speed
+		uint8_t OD = (psEB->Conf & 0x08) ? 1 : 0 ;
+		uint8_t Val = (psEB->PadjIdx << 5) | (OD << 4) | psEB->Padj[psEB->PadjIdx][OD] ;
+		psEB->PadjIdx = (psEB->PadjIdx + 1) % 5 ;
+		return Val ; }
+	}
+	return 0xFF ;
+}
+
+// ########################################## Public API ###########################################
+
+int	ds248xEmulAddBridge(uint8_t Type) {
+	IF_myASSERT(debugPARAM, Type == i2cDEV_DS2482_10X || Type == i2cDEV_DS2482_800 || Type == i2cDEV_DS2484) ;
+	if (EmulCount == ds248xEMUL_MAXBRIDGE) return erFAILURE ;
+	emul_bridge_t * psEB = &saEmul[EmulCount] ;
+	memset(psEB, 0, sizeof(emul_bridge_t)) ;
+	psEB->Type = Type ;
+	ds248xEmulDeviceReset(psEB) ;
+	return EmulCount++ ;
+}
+
+/**
+ * @brief	add a virtual DS18S20 (0x10), DS18B20 (0x28), DS1990 (0x01) or overdrive/Resume capable
+ *			(OWFamilyCaps) device. DS28EA00 (0x42) has the DS18B20 scratchpad, others ROM only
+ * @param	Traw - temperature in 1/16C units (ignored without scratchpad)
+ * @return	index of device on channel or erFAILURE
+ */
+int	ds248xEmulAddDevice(uint8_t Bridge, uint8_t Chan, uint8_t Family, bool Pwr, int16_t Traw) {
+	IF_myASSERT(debugPARAM, Family == OWFAMILY_01 || Family == OWFAMILY_10 || Family == OWFAMILY_28 || OWFamilyCaps(Family)) ;
+	if (Bridge >= EmulCount) return erFAILURE ;
+	emul_bridge_t * psEB = &saEmul[Bridge] ;
+	if (Chan >= ((psEB->Type == i2cDEV_DS2482_800) ? 8 : 1)) return erFAILURE ;
+	emul_chan_t * psEC = &psEB->Chan[Chan] ;
+	if (psEC->NumDev == ds248xEMUL_MAXOWDEV) return erFAILURE ;
+	emul_owdev_t * psOD = &psEC->Dev[psEC->NumDev] ;
+	memset(psOD, 0, sizeof(emul_owdev_t)) ;
+	psOD->ROM.Family = Family ;
+	// deterministic, unique serial: bridge, channel, index & a spread value
+	uint32_t Seed = 0x9E3779B9U * (1 + (Bridge << 8 | Chan << 4 | psEC->NumDev)) ;
+	psOD->ROM.TagNum[0] = psEC->NumDev ;
+	psOD->ROM.TagNum[1] = Chan ;
+	psOD->ROM.TagNum[2] = Bridge ;
+	memcpy(&psOD->ROM.TagNum[3], &Seed, 3) ;
+	psOD->ROM.CRC = ds248xEmulCRC8(psOD->ROM.HexChars, sizeof(ow_rom_t) - 1) ;
+	psOD->Pwr = Pwr ;
+	psOD->ODcap = (OWFamilyCaps(Family) & owCAP_OD) ? 1 : 0 ;
+	psOD->RCcap = (OWFamilyCaps(Family) & owCAP_RESUME) ? 1 : 0 ;
+	psOD->Res = (Family == OWFAMILY_28 || Family == OWFAMILY_42) ;
+	psOD->Therm = (Family == OWFAMILY_10 || psOD->Res) ;
+	if (psOD->Therm) {
+		if (Family == OWFAMILY_10) Traw = (Traw >> 3) ;	// 0.5C resolution
+		psOD->SP[0] = Traw & 0xFF ;
+		psOD->SP[1] = Traw >> 8 ;
+		psOD->SP[2] = psOD->EE[0] = 75 ;
+		psOD->SP[3] = psOD->EE[1] = 70 ;
+		psOD->SP[4] = psOD->EE[2] = psOD->Res ? 0x7F : 0xFF ;
+		psOD->SP[5] = 0xFF ;
+		psOD->SP[6] = 0x0C ;
+		psOD->SP[7] = 0x10 ;
+		ds248xEmulUpdateCRC(psOD) ;
+	}
+	return psEC->NumDev++ ;
+}
+
+/**
+ * @brief	identify & configure all virtual bridges, as the I2C bus scan would
+ * @return	number of bridges configured
+ */
+int	ds248xEmulStart(void) {
+	int iRV = 0 ;
+	for (int i = 0; i < EmulCount; ++i) {
+		i2c_di_t * psI2C = &saEmul[i].sI2C ;
+		if (ds248xIdentify(psI2C) == erSUCCESS) ++iRV ;
+	}
+	for (int i = 0; i < EmulCount; ++i) {
+		i2c_di_t * psI2C = &saEmul[i].sI2C ;
+		if (psI2C->Type != i2cDEV_UNDEF) ds248xConfig(psI2C) ;
+	}
+	ds248xEmulResetCounters() ;
+	return iRV ;
+}
+
+/**
+ * @brief	replacement for halI2C_Queue() when ds248xBUILD_EMUL is enabled
+ */
+int	ds248xEmulQueue(i2c_di_t * psI2C, int eType, uint8_t * pTxBuf, size_t TxSize,
+					uint8_t * pRxBuf, size_t RxSize, i2cq_p1_t p1, i2cq_p2_t p2) {
+	emul_bridge_t * psEB = ds248xEmulBridge(psI2C) ;
+	if (eType == i2cR_B) {								// read only, single buffer supplied
+		pRxBuf	= pTxBuf ;
+		RxSize	= TxSize ;
+		TxSize	= 0 ;
+	}
+	ds248xEmulChargeI2C(psEB, TxSize, RxSize) ;
+	// DS2482 rated for 400KHz, DS2484 for 1MHz, faster is not acknowledged
+	if (psEB->sI2C.Speed > ((psEB->Type == i2cDEV_DS2484) ? i2cSPEED_1000 : i2cSPEED_400)) {
+		++psEB->Nack ;
+		return erFAILURE ;
+	}
+	bool Fail = psEB->FailCount && (psEB->FailCmd == 0 || (TxSize && pTxBuf[0] == psEB->FailCmd)) ;
+	if (Fail) {
+		--psEB->FailCount ;
+		if (psEB->FailDone == 0) {
+			++psEB->Nack ;
+			return erFAILURE ;
+		}
+	}
+	for (size_t i = 0; i < TxSize; ) {
+		int Used = ds248xEmulCommand(psEB, &pTxBuf[i], TxSize - i) ;
+		if (Used == 0) {
+			++psEB->Nack ;
+			return erFAILURE ;
+		}
+		i += Used ;
+	}
+	if (eType == i2cWDR_B) EmulNow += (uintptr_t) p1 ;	// driver requested delay
+	if (Fail) {											// executed, read phase lost
+		++psEB->Nack ;
+		return erFAILURE ;
+	}
+	for (size_t i = 0; i < RxSize; ++i) pRxBuf[i] = ds248xEmulReadRegister(psEB) ;
+	return erSUCCESS ;
+}
+
+uint64_t ds248xEmulMicros(void) { return EmulNow ; }
+
+/**
+ * @brief	charge time spent outside the driver, eg vTaskDelay(), to the virtual clock
+ */
+void	ds248xEmulIdle(uint64_t uS) { EmulNow += uS ; }
+
+/**
+ * @brief	I2C transactions, all bridges, since the last ds248xEmulResetCounters()
+ */
+uint32_t ds248xEmulTrans(void) {
+	uint32_t Trans = 0 ;
+	for (int i = 0; i < EmulCount; Trans += saEmul[i++].Trans) ;
+	return Trans ;
+}
+
+/**
+ * @brief	fault injection, 1-Wire commands of the bridge take Pct % longer than nominal
+ *			(slow oscillator or stretched slots), DATA read early returns the previous byte
+ */
+int	ds248xEmulSlow(uint8_t Bridge, uint8_t Pct) {
+	if (Bridge >= EmulCount) return erFAILURE ;
+	saEmul[Bridge].Slow = Pct ;
+	return erSUCCESS ;
+}
+
+/**
+ * @brief	fault injection, NACK the next Count I2C transactions starting with Cmd (0 = any)
+ * @param	Done - 0 NACK'ed before, 1 after the commands were executed
+ */
+int	ds248xEmulFail(uint8_t Bridge, uint8_t Cmd, uint8_t Count, bool Done) {
+	if (Bridge >= EmulCount) return erFAILURE ;
+	saEmul[Bridge].FailCmd		= Cmd ;
+	saEmul[Bridge].FailCount	= Count ;
+	saEmul[Bridge].FailDone		= Done ;
+	return erSUCCESS ;
+}
+
+/**
+ * @brief	strong pullups started by the bridge since the last ds248xEmulResetCounters()
+ */
+uint32_t ds248xEmulSpu(uint8_t Bridge) { return (Bridge < EmulCount) ? saEmul[Bridge].Spu : 0 ; }
+
+void ds248xEmulResetCounters(void) {
+	for (int i = 0; i < EmulCount; ++i) {
+		saEmul[i].tBus	= 0 ;
+		saEmul[i].Trans	= 0 ;
+		saEmul[i].Bytes	= 0 ;
+		saEmul[i].Nack	= 0 ;
+		saEmul[i].Spu	= 0 ;
+	}
+}
+
+// ######################################### Trace replay ##########################################
+
+/**
+ * @brief	Feed an exported ds248xTraceExport() trace through the virtual bridges & buses
+ * @return	records returning a different byte than recorded, erFAILURE if trace invalid
+ * @note	Bridges must be populated as in the field. Bridge & bus state at the start of
+ *			the trace is not recorded, early records after a wrap may differ.
+ *			Recorded idle time between transactions is kept, records the virtual bus could
+ *			not start at their recorded time are counted as late.
+ */
+int	ds248xEmulReplay(uint8_t * pBuf, size_t Size) {
+	ds248x_trace_hdr_t * psHdr = (ds248x_trace_hdr_t *) pBuf ;
+	if (Size < sizeof(ds248x_trace_hdr_t) || psHdr->Magic[0] != 'D' || psHdr->Magic[1] != 'T' ||
+		psHdr->RecSize != sizeof(ds248x_trace_t) ||
+		Size < sizeof(ds248x_trace_hdr_t) + (psHdr->Count * sizeof(ds248x_trace_t))) return erFAILURE ;
+	ds248x_trace_t * psT = (ds248x_trace_t *) (pBuf + sizeof(ds248x_trace_hdr_t)) ;
+	uint64_t tStart = EmulNow ;
+	uint32_t tFirst = psT->Time, tLast = psT->Time ;
+	uint32_t Diff = 0, Skip = 0, Late = 0 ;
+	for (uint32_t i = 0; i < psHdr->Count; ++i, ++psT) {
+		if (psT->Dev >= EmulCount || psT->OK == 0) {	// unknown bridge or failed in the field
+			++Skip ;
+			continue ;
+		}
+		uint64_t tDue = tStart + (uint32_t) (psT->Time - tFirst) ;
+		if (EmulNow < tDue) EmulNow = tDue ;
+		else if (EmulNow > tDue) ++Late ;
+		tLast = psT->Time ;
+		emul_bridge_t * psEB = &saEmul[psT->Dev] ;
+		uint8_t Rx = 0 ;
+		if (psT->TxLen) {
+			ds248xEmulQueue(&psEB->sI2C, i2cWDR_B, psT->Tx, psT->TxLen, &Rx, 1, (i2cq_p1_t) (uintptr_t) psT->Delay, (i2cq_p2_t) NULL) ;
+		} else {
+			ds248xEmulQueue(&psEB->sI2C, i2cR_B, &Rx, 1, NULL, 0, (i2cq_p1_t) NULL, (i2cq_p2_t) NULL) ;
+		}
+		if (Rx != psT->Rx) {
+			if (Diff < 8) printfx("REPLAY #%u D=%u C=%u Cmd=%02X %s=%02X expected %02X\n", i, psT->Dev,
+									psT->Chan, psT->Tx[0], psT->TxLen ? "Wr" : "Rd", Rx, psT->Rx) ;
+			++Diff ;
+		}
+	}
+	printfx("REPLAY n=%u  Skip=%u  Diff=%u  Late=%u  Recorded=%uuS  Emulated=%lluuS\n", psHdr->Count,
+			Skip, Diff, Late, tLast - tFirst, EmulNow - tStart) ;
+	return Diff ;
+}
+
+// ########################################### Reporting ###########################################
+
+void ds248xEmulReport(void) {
+	uint64_t tBus = 0 ;
+	uint32_t Trans = 0 ;
+	for (int i = 0; i < EmulCount; ++i) {
+		emul_bridge_t * psEB = &saEmul[i] ;
+		printfx("EMUL #%d Type=%d  Trans=%u  Bytes=%u  Nack=%u  Bus=%lluuS\n", i, psEB->Type,
+				psEB->Trans, psEB->Bytes, psEB->Nack, psEB->tBus) ;
+		tBus	+= psEB->tBus ;
+		Trans	+= psEB->Trans ;
+	}
+	printfx("EMUL Now=%lluuS  Trans=%u  Bus=%lluuS\n", EmulNow, Trans, tBus) ;
+}
+
+/**
+ * @brief	I2C transactions & bus time for a full scratchpad read of the first DS18x20
+ * @return	I2C transactions used
+ */
+uint32_t ds248xEmulBenchmark(void) {
+	if (Fam10_28Count == 0) return 0 ;
+	ds18x20_t * psDS18X20 = &psaDS18X20[0] ;
+	emul_bridge_t * psEB = ds248xEmulBridge(psaDS248X[psDS18X20->sOW.DevNum].psI2C) ;
+	if (OWP_BusSelect(&psDS18X20->sOW) == 0) return 0 ;
+	uint32_t Trans = psEB->Trans ;
+	uint64_t tBus = psEB->tBus ;
+	ds18x20ReadSP(psDS18X20, SO_MEM(ds18x20_t, RegX)) ;
+	OWP_BusRelease(&psDS18X20->sOW) ;
+	printfx("EMUL ReadSP(9): Trans=%u  Bus=%lluuS\n", psEB->Trans - Trans, psEB->tBus - tBus) ;
+	return psEB->Trans - Trans ;
+}
+
+#endif
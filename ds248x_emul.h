@@ -0,0 +1,60 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * ds248x_emul.h - DS248x bridge & 1-Wire bus emulator
+ */
+
+#pragma		once
+
+#include	"hal_i2c.h"
+
+#include	<stdint.h>
+#include	<stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Answers the exact halI2C_Queue() transactions issued by ds248xI2C_Read() and
+ * ds248xI2C_WriteDelayRead() for DS2482-10x, DS2482-800 and DS2484 bridges, each
+ * channel populated with virtual DS18S20, DS18B20 and DS1990 devices.
+ * A virtual clock is charged with the I2C bit time of every transaction, the 1-Wire
+ * duration of every command and the delay requested by the driver.
+ *
+ * Enable with ds248xBUILD_EMUL in ds248x.h, then before OWP_Config():
+ *		ds248xEmulAddBridge(i2cDEV_DS2482_800) ;
+ *		ds248xEmulAddDevice(0, 3, OWFAMILY_28, 1, 0x0191) ;
+ *		ds248xEmulStart() ;
+ * The Linux host build in test/ enables it and charges vTaskDelay() with ds248xEmulIdle().
+ */
+
+// ############################################# Macros ############################################
+
+#define	ds248xEMUL_MAXBRIDGE		4
+#define	ds248xEMUL_MAXCHAN			8
+#define	ds248xEMUL_MAXOWDEV			8					// per channel
+
+// ###################################### Public functions #########################################
+
+int		ds248xEmulAddBridge(uint8_t Type) ;
+int		ds248xEmulAddDevice(uint8_t Bridge, uint8_t Chan, uint8_t Family, bool Pwr, int16_t Traw) ;
+int		ds248xEmulStart(void) ;
+
+int		ds248xEmulQueue(i2c_di_t * psI2C, int eType, uint8_t * pTxBuf, size_t TxSize,
+						uint8_t * pRxBuf, size_t RxSize, i2cq_p1_t p1, i2cq_p2_t p2) ;
+uint64_t ds248xEmulMicros(void) ;
+void	ds248xEmulIdle(uint64_t uS) ;
+uint32_t ds248xEmulTrans(void) ;
+int		ds248xEmulSlow(uint8_t Bridge, uint8_t Pct) ;
+int		ds248xEmulFail(uint8_t Bridge, uint8_t Cmd, uint8_t Count, bool Done) ;
+uint32_t ds248xEmulSpu(uint8_t Bridge) ;
+void	ds248xEmulResetCounters(void) ;
+void	ds248xEmulReport(void) ;
+uint32_t ds248xEmulBenchmark(void) ;
+int		ds248xEmulReplay(uint8_t * pBuf, size_t Size) ;
+
+#ifdef __cplusplus
+}
+#endif
@@ -10,16 +10,10 @@
 #include	"syslog.h"
 #include	"x_errors_events.h"
 
-#ifdef	ESP_PLATFORM
-	#include	"esp32/rom/crc.h"					// ESP32 ROM routine
-#else
-	#include	"crc-barr.h"						// Barr group CRC
-#endif
 
 #include	<string.h>
-#include	<limits.h>
 
-#define	debugFLAG					0xD007
+#define	debugFLAG					0xD003
 
 #define	debugBUS_CFG				(debugFLAG & 0x0001)
 #define	debugCONFIG					(debugFLAG & 0x0002)
@@ -46,12 +40,53 @@
 
 // ################################# Basic 1-Wire operations #######################################
 
+#if		(owBUILD_RESUME > 0)
+	#define	IF_OWRESUME_CLEAR(psOW)		OWP_BusResumeSet(OWP_BusP2L(psOW), 0ULL)
+#else
+	#define	IF_OWRESUME_CLEAR(psOW)
+#endif
+
 /**
  * Reset all of the devices on the 1-Wire Net and return the result.
  * @return	1 if presence pulse(s) detected, device(s) reset
  *			0 if no presence pulse(s) detected
  */
-int		OWReset(owdi_t * psOW) { return ds248xOWReset(&psaDS248X[psOW->DevNum]) ; }
+#if		(owBUILD_OVERDRIVE > 0)
+/* Overdrive reset only if requested AND devices on the channel are still in overdrive, else
+ * standard speed reset which returns ALL devices on the channel to standard speed */
+static bool OWSpeedSelect(owdi_t * psOW, bool OD) {
+	ds248x_t * psDS248X = ds248xDEV(psOW->DevNum) ;
+	OD = OD && OWP_BusODGet(OWP_BusP2L(psOW)) ;
+	if (psDS248X->OWS != OD) ds248xOWSpeed(psDS248X, OD) ;
+	return OD ;
+}
+
+/* This device switched by Overdrive Match ROM, or with all capable devices by Overdrive Skip ROM.
+ * Any other device needs a standard speed reset & Overdrive Match ROM first */
+static bool OWSpeedPromoted(owdi_t * psOW) {
+	uint64_t ODrom = OWP_BusODGet(OWP_BusP2L(psOW)) ;
+	return (ODrom == psOW->ROM.Value) || (ODrom == owbiOD_ALL && (OWFamilyCaps(psOW->ROM.Family) & owCAP_OD)) ;
+}
+
+/* No presence at overdrive, device lost overdrive, demote so the retry runs at standard speed */
+static void OWSpeedDemote(owdi_t * psOW) {
+	SL_ERR("Dev=%d Ch=%d overdrive lost, demoted", psOW->DevNum, psOW->PhyBus) ;
+	psOW->OD = 0 ;
+	ds248xOWSpeed(ds248xDEV(psOW->DevNum), owSPEED_STANDARD) ;
+}
+
+static int OWResetSpeed(owdi_t * psOW, bool OD) {
+	ds248x_t * psDS248X = ds248xDEV(psOW->DevNum) ;
+	OD = OWSpeedSelect(psOW, OD && OWSpeedPromoted(psOW)) ;
+	if (ds248xOWReset(psDS248X) || OD == 0) return psDS248X->PPD ;
+	OWSpeedDemote(psOW) ;
+	return ds248xOWReset(psDS248X) ;
+}
+
+int		OWReset(owdi_t * psOW) { return OWResetSpeed(psOW, psOW->OD) ; }
+#else
+int		OWReset(owdi_t * psOW) { return ds248xOWReset(ds248xDEV(psOW->DevNum)) ; }
+#endif
 
 /**
  * Send 1 bit of communication to the 1-Wire Net and return the
@@ -64,7 +99,7 @@ int		OWReset(owdi_t * psOW) { return ds248xOWReset(&psaDS248X[psOW->DevNum]) ; }
  * Returns: 0:	0 bit read from sendbit
  *			 1:	1 bit read from sendbit
  */
-uint8_t OWTouchBit(owdi_t * psOW, uint8_t Bit) { return ds248xOWTouchBit(&psaDS248X[psOW->DevNum], Bit) ; }
+uint8_t OWTouchBit(owdi_t * psOW, uint8_t Bit) { return ds248xOWTouchBit(ds248xDEV(psOW->DevNum), Bit) ; }
 
 /**
  * Send 1 bit of communication to the 1-Wire Net.
@@ -93,13 +128,13 @@ uint8_t OWReadBit(owdi_t * psOW) { return OWTouchBit(psOW, 0x01) ; }
  * @param	psOW
  * @param	Byte
  */
-void	OWWriteByte(owdi_t * psOW, uint8_t Byte) { ds248xOWWriteByte(&psaDS248X[psOW->DevNum], Byte) ; }
+void	OWWriteByte(owdi_t * psOW, uint8_t Byte) { ds248xOWWriteByte(ds248xDEV(psOW->DevNum), Byte) ; }
 
 /**
  * Reads 8 bits of communication from the 1-Wire Net
  * @return	8 bits read from 1-Wire Net
  */
-uint8_t	OWReadByte(owdi_t * psOW) { return ds248xOWReadByte(&psaDS248X[psOW->DevNum]) ; }
+uint8_t	OWReadByte(owdi_t * psOW) { return ds248xOWReadByte(ds248xDEV(psOW->DevNum)) ; }
 
 /**
  * Send 8 bits of communication to the 1-Wire Net and return the
@@ -174,74 +209,40 @@ void	OWFamilySkipSetup(owdi_t * psOW) {
  * Returns:	1 if 1W device was found (Serial Number placed in the global ROM)
  *			0 if NO 1W device found. Either last search was last device or
  *			there are no devices on the 1-Wire Net.
+ * @note	Reset, command and triplets run in ds248xOWSearch(), submit ds248xREQ_SEARCH to
+ *			have the device worker run the whole search as one job.
  */
 int 	OWSearch(owdi_t * psOW, bool alarm_only) {
-	bool	search_result = 0, search_direction ;
-	uint8_t	rom_byte_number = 0, last_zero = 0, id_bit_number = 1, rom_byte_mask = 1, status ;
-	psOW->crc8 = 0;
-	if (psOW->LDF == 0) {					// if the last call was not the last device
-		if (OWReset(psOW) == 0) {						// reset the search
-			psOW->LD	= 0 ;
-			psOW->LDF	= 0 ;
-			psOW->LFD	= 0 ;
-			return 0 ;
-		}
-		OWWriteByte(psOW, alarm_only ? OW_CMD_SEARCHALARM : OW_CMD_SEARCHROM) ;
-		do {											// loop to do the search
-		// if this discrepancy is before the Last Discrepancy
-		// on a previous next then pick the same as last time
-			if (id_bit_number < psOW->LD) {
-				search_direction = ((psOW->ROM.HexChars[rom_byte_number] & rom_byte_mask) > 0) ? 1 : 0 ;
-			} else {									// if equal to last pick 1, if not then pick 0
-				search_direction = (id_bit_number == psOW->LD) ? 1 : 0 ;
-			}
-		// Perform a triple operation on the DS2482 which will perform 2 read bits and 1 write bit
-			status = ds248xOWSearchTriplet(&psaDS248X[psOW->DevNum], search_direction) ;
-		// check bit results in status byte
-			int	id_bit		= ((status & ds248xSTAT_SBR) == ds248xSTAT_SBR) ;
-			int	cmp_id_bit	= ((status & ds248xSTAT_TSB) == ds248xSTAT_TSB) ;
-			search_direction	= ((status & ds248xSTAT_DIR) == ds248xSTAT_DIR) ? 1 : 0 ;
-			if ((id_bit) && (cmp_id_bit)) {				// check for no devices on 1-Wire
-				break ;
-			} else {
-				if ((!id_bit) && (!cmp_id_bit) && (search_direction == 0)) {
-					last_zero = id_bit_number ;
-					if (last_zero < 9) {				// check for Last discrepancy in family
-						psOW->LFD = last_zero ;
-					}
-				}
-				if (search_direction == 1) {			// set or clear the bit in the ROM byte rom_byte_number with mask rom_byte_mask
-					psOW->ROM.HexChars[rom_byte_number] |= rom_byte_mask ;
-				} else {
-					psOW->ROM.HexChars[rom_byte_number] &= ~rom_byte_mask ;
-				}
-				++id_bit_number ;						// increment the byte counter id_bit_number & shift the mask rom_byte_mask
-				rom_byte_mask <<= 1 ;
-				if (rom_byte_mask == 0) {				// if the mask is 0 then go to new SerialNum byte rom_byte_number and reset mask
-					OWCalcCRC8(psOW, psOW->ROM.HexChars[rom_byte_number]);  // accumulate the CRC
-					++rom_byte_number ;
-					rom_byte_mask = 1 ;
-				}
-			}
-		} while(rom_byte_number < sizeof(ow_rom_t)) ;	// loop until all
-	// if the search was successful then
-		if (!((id_bit_number < 65) || (psOW->crc8 != 0))) {
-			psOW->LD = last_zero;			// search successful
-			if (psOW->LD == 0) {			// last device ?
-				psOW->LDF	= 1 ;			// yes, set flag
-			}
-			search_result = 1 ;
-		}
+	IF_OWHIST_START(tH) ;
+	ds248x_t * psDS248X = ds248xDEV(psOW->DevNum) ;
+	ds248x_srch_t sS = {
+		.Cmd = alarm_only ? OW_CMD_SEARCHALARM : OW_CMD_SEARCHROM,
+		.LD = psOW->LD, .LFD = psOW->LFD, .LDF = psOW->LDF,
+	} ;
+	memcpy(sS.ROM, psOW->ROM.HexChars, sizeof(sS.ROM)) ;
+#if		(owBUILD_OVERDRIVE > 0)
+	ds248x_srch_t sEntry = sS ;
+	bool OD = OWSpeedSelect(psOW, psOW->OD) ;			// reset issued by the search itself
+	int iRV = ds248xOWSearch(psDS248X, &sS) ;
+	if (iRV == 0 && OD && sEntry.LDF == 0 && psDS248X->PPD == 0) {	// as OWResetSpeed()
+		OWSpeedDemote(psOW) ;
+		sS = sEntry ;
+		iRV = ds248xOWSearch(psDS248X, &sS) ;
 	}
-
-	// if no device found then reset counters so next 'search' will be like a first
-	if (!search_result || (psOW->ROM.Family == 0)) {
-		psOW->LD	= 0 ;
-		psOW->LDF	= 0 ;
-		psOW->LFD = 0 ;
-		search_result = 0 ;
+#else
+	int iRV = ds248xOWSearch(psDS248X, &sS) ;
+#endif
+	memcpy(psOW->ROM.HexChars, sS.ROM, sizeof(sS.ROM)) ;
+	psOW->LD	= sS.LD ;
+	psOW->LFD	= sS.LFD ;
+	psOW->LDF	= sS.LDF ;
+	psOW->crc8	= sS.Crc ;
+	if (iRV == 0 && sS.Bits) {							// devices responded, search failed
+		if (sS.Bits == 64 && sS.Crc) OWP_BusEvent(OWP_BusP2L(psOW), owbiEV_CRC) ;
+		OWP_BusEvent(OWP_BusP2L(psOW), owbiEV_ABORT) ;
 	}
-	return search_result ;
+	IF_OWHIST_STOP(&OWP_Hist[owpH_SEARCH], tH) ;
+	return iRV ;
 }
 
 /**
@@ -263,6 +264,130 @@ int		OWFirst(owdi_t * psOW, bool alarm_only) {
  */
 int 	OWNext(owdi_t * psOW, bool alarm_only) { return OWSearch(psOW, alarm_only) ; }
 
+/**
+ * OWRomCompare() - order by family, then serial number (MS byte first), then CRC
+ * @return	<0, 0 or >0 as for memcmp()
+ */
+int		OWRomCompare(const ow_rom_t * psA, const ow_rom_t * psB) {
+	static const uint8_t Order[sizeof(ow_rom_t)] = { 0, 6, 5, 4, 3, 2, 1, 7 } ;
+	for (int i = 0; i < sizeof(ow_rom_t); ++i) {
+		int Diff = psA->HexChars[Order[i]] - psB->HexChars[Order[i]] ;
+		if (Diff) return Diff ;
+	}
+	return 0 ;
+}
+
+/**
+ * @brief	Insert sROM into sorted paROM[Count] unless already present
+ * @return	1 if new (stored or, with paROM full and sROM sorting last, dropped) else 0
+ */
+static int OWRomInsert(ow_rom_t * paROM, int Count, int Size, ow_rom_t sROM) {
+	int Lo = 0, Hi = Count ;
+	while (Lo < Hi) {
+		int Mid = (Lo + Hi) / 2 ;
+		int Diff = OWRomCompare(&paROM[Mid], &sROM) ;
+		if (Diff == 0) return 0 ;
+		if (Diff < 0) Lo = Mid + 1 ;
+		else Hi = Mid ;
+	}
+	if (Lo == Size) return 1 ;
+	if (Count == Size) --Count ;						// full, drop the last entry
+	memmove(&paROM[Lo + 1], &paROM[Lo], (Count - Lo) * sizeof(ow_rom_t)) ;
+	paROM[Lo] = sROM ;
+	return 1 ;
+}
+
+/**
+ * OWSearchAll() - Enumerate the (selected) bus into a sorted, duplicate free ROM array
+ * @param	psOW - bus (DevNum & PhyBus) to search, search state not used nor changed
+ * @param	paROM - receives at most Size ROMs, sorted as per OWRomCompare()
+ * @param	paFam - families to keep, NULL for all. Other families are skipped as a
+ *			whole, the search does not visit their remaining devices
+ * @param	alarm_only - only devices in alarm state
+ * @return	number of distinct ROMs found, if > Size only the Size lowest are in paROM
+ */
+int		OWSearchAll(owdi_t * psOW, ow_rom_t * paROM, int Size, const uint8_t * paFam, int FamNum, bool alarm_only) {
+	owdi_t	sOW = *psOW ;
+	int		Count = 0 ;
+	int		iRV ;
+	if (paFam && FamNum == 1) {							// family devices are contiguous in search order
+		OWTargetSetup(&sOW, paFam[0]) ;
+		iRV = OWSearch(&sOW, alarm_only) ;
+	} else {
+		iRV = OWFirst(&sOW, alarm_only) ;
+	}
+	while (iRV) {
+		int i = 0 ;
+		if (paFam) while (i < FamNum && paFam[i] != sOW.ROM.Family) ++i ;
+		if (paFam && i == FamNum) {						// family not wanted
+			if (FamNum == 1) break ;					// past the target family
+			OWFamilySkipSetup(&sOW) ;
+		} else if (OWRomInsert(paROM, (Count < Size) ? Count : Size, Size, sOW.ROM)) {
+			++Count ;
+		}
+		iRV = OWSearch(&sOW, alarm_only) ;
+	}
+	return Count ;
+}
+
+/**
+ * @brief	Walk the search path of one known ROM comparing each branch against the known set
+ * @param	Branch - bit n set if some other known ROM first differs from Value at bit n
+ * @return	1 if the bus matches the known set along this path, 0 if it differs
+ * @note	Above the last known branch a new device shows as an unexpected branch, a removed
+ *			one as a missing branch. Below it the path is only followed for owDELTA_TAIL bits,
+ *			bits 56-63 (CRC) are implied by the preceding ones.
+ */
+static int OWSearchDeltaPath(owdi_t * psOW, uint64_t Value, uint64_t Branch) {
+	int Stop = Branch ? (64 - __builtin_clzll(Branch)) : 8 ;	// at least the family
+	Stop = (Stop + owDELTA_TAIL > 56) ? 56 : Stop + owDELTA_TAIL ;
+	if (OWReset(psOW) == 0) return 0 ;
+	OWWriteByte(psOW, OW_CMD_SEARCHROM) ;
+	IF_OWRESUME_CLEAR(psOW) ;
+	ds248x_t * psDS248X = ds248xDEV(psOW->DevNum) ;
+	for (int b = 0; b < Stop; ++b) {
+		bool Bit = (Value >> b) & 1 ;
+		uint8_t Stat = ds248xOWSearchTriplet(psDS248X, Bit) ;
+		bool Has0 = (Stat & ds248xSTAT_SBR) == 0 ;		// some device has a 0 bit here
+		bool Has1 = (Stat & ds248xSTAT_TSB) == 0 ;		// some device has a 1 bit here
+		if ((Bit ? Has1 : Has0) == 0) return 0 ;		// this ROM (and its subtree) gone
+		if ((Bit ? Has0 : Has1) != ((Branch >> b) & 1)) return 0 ;	// branch added or removed
+	}
+	return psDS248X->OWErr == 0 ;						// unsure, full search decides
+}
+
+int	OWSearchDelta(owdi_t * psOW, const ow_rom_t * paKnown, int Known, ow_rom_t * paROM, int Size, int * pCount) {
+	int Path ;
+	owdi_t sOW = *psOW ;
+	if (Known == 0) {
+		Path = (OWReset(&sOW) == 0) ;					// no presence, still empty
+	} else {
+		for (Path = 0; Path < Known; ++Path) {
+			uint64_t Branch = 0 ;
+			for (int j = 0; j < Known; ++j) {
+				uint64_t Diff = paKnown[Path].Value ^ paKnown[j].Value ;
+				if (Diff) Branch |= (1ULL << __builtin_ctzll(Diff)) ;
+			}
+			if (OWSearchDeltaPath(&sOW, paKnown[Path].Value, Branch) == 0) break ;
+		}
+		Path = (Path == Known) ;
+	}
+	if (Path) return 0 ;
+	// changed, full search then count the differences
+	int Count = OWSearchAll(&sOW, paROM, Size, NULL, 0, 0) ;
+	int Stored = (Count < Size) ? Count : Size ;
+	int Changes = 0, i = 0, j = 0 ;
+	while (i < Known || j < Stored) {
+		int Diff = (i == Known) ? 1 : (j == Stored) ? -1 : OWRomCompare(&paKnown[i], &paROM[j]) ;
+		if (Diff <= 0) ++i ;
+		if (Diff >= 0) ++j ;
+		if (Diff) ++Changes ;
+	}
+	*pCount = Count ;
+	IF_SL_INFO(debugTRACK, "Dev=%d Bus=%d Known=%d Now=%d Changes=%d", psOW->DevNum, psOW->PhyBus, Known, Count, Changes) ;
+	return Changes + (Count - Stored) ;					// those not stored are new
+}
+
 // ################################## Extended 1-Wire operations ###################################
 
 /**
@@ -271,7 +396,7 @@ int 	OWNext(owdi_t * psOW, bool alarm_only) { return OWSearch(psOW, alarm_only)
  * @param	speed - owSPEED_STANDARD or owSPEED_OVERDRIVE
  * @return	new current 1W speed (0 = Standard, 1= Overdrive)
  */
-int		OWSpeed(owdi_t * psOW, bool speed) { return ds248xOWSpeed(&psaDS248X[psOW->DevNum], speed) ; }
+int		OWSpeed(owdi_t * psOW, bool speed) { return ds248xOWSpeed(ds248xDEV(psOW->DevNum), speed) ; }
 
 /**
  * Set the 1-Wire Net line level pull-up to normal.
@@ -280,7 +405,7 @@ int		OWSpeed(owdi_t * psOW, bool speed) { return ds248xOWSpeed(&psaDS248X[psOW->
  *		STRONG		1
  * Returns:  current 1-Wire Net level
  */
-int		OWLevel(owdi_t * psOW, bool level) { return ds248xOWLevel(&psaDS248X[psOW->DevNum], level) ; }
+int		OWLevel(owdi_t * psOW, bool level) { return ds248xOWLevel(ds248xDEV(psOW->DevNum), level) ; }
 
 /**
  * Send 1 bit of communication to the 1-Wire Net and verify that the
@@ -315,21 +440,29 @@ int		OWReadBitPower(owdi_t * psOW, uint8_t applyPowerResponse) {
  * Returns:  1: bytes written and echo was the same, strong pullup now on
  *			  0: echo was not the same
  */
+int		OWWriteBytePower(owdi_t * psOW, int Byte) { return ds248xOWWriteBytePower(ds248xDEV(psOW->DevNum), Byte) ; }
+
+// ################################## Utility 1-Wire operations ####################################
+
 /**
- * @brief
- * @param	psOW
- * @param	Byte - value to be sent on the bus
- * @return
+ * OWFamilyCaps() - Capabilities (owCAP_*) common to all devices of a family
+ * @note	Conservative, family 0x01 excluded since DS1990A/DS2401 do not support overdrive
+ *			Resume only where the datasheet documents the RC flag, NOT DS18B20/DS18S20
  */
-int		OWWriteBytePower(owdi_t * psOW, int Byte) {
-	if (OWSetSPU(psOW) == 0) return 0 ;
-	OWWriteByte(psOW, Byte) ;
-	return 1 ;
+uint8_t	OWFamilyCaps(uint8_t Family) {
+	switch (Family) {
+	case OWFAMILY_04:	case OWFAMILY_06:	case OWFAMILY_08:	case OWFAMILY_0A:
+	case OWFAMILY_0C:	case OWFAMILY_12:	case OWFAMILY_1A:	case OWFAMILY_1D:
+	case OWFAMILY_20:	case OWFAMILY_23:
+		return owCAP_OD ;
+	case OWFAMILY_1C:	case OWFAMILY_29:	case OWFAMILY_2D:	case OWFAMILY_37:
+	case OWFAMILY_3A:	case OWFAMILY_41:	case OWFAMILY_42:	case OWFAMILY_43:
+		return owCAP_OD | owCAP_RESUME ;
+	}
+	return 0 ;											// DS18S20/DS18B20 standard speed, no Resume
 }
 
-// ################################## Utility 1-Wire operations ####################################
-
-int	OWSetSPU(owdi_t * psOW) { return ds248xOWSetSPU(&psaDS248X[psOW->DevNum]) ; }
+int	OWSetSPU(owdi_t * psOW) { return ds248xOWSetSPU(ds248xDEV(psOW->DevNum)) ; }
 
 /**
  * OWCheckCRC() - Checks if CRC is ok (ROM Code or Scratch PAD RAM)
@@ -338,18 +471,9 @@ int	OWSetSPU(owdi_t * psOW) { return ds248xOWSetSPU(&psaDS248X[psOW->DevNum]) ;
  * @return	1 if the CRC is correct, 0 otherwise
  */
 uint8_t	OWCheckCRC(uint8_t * buf, uint8_t buflen) {
-	uint8_t data_bit, sr_lsb, fb_bit, shift_reg = 0 ;
-	for (int iByte = 0; iByte < buflen; iByte++) {
-		for (int iBit = 0; iBit < CHAR_BIT; iBit++) {
-			data_bit	= (buf[iByte] >> iBit) & 0x01 ;
-			sr_lsb		= shift_reg & 0x01 ;
-			fb_bit		= (data_bit ^ sr_lsb) & 0x01 ;
-			shift_reg	= shift_reg >> 1 ;
-			if (fb_bit) shift_reg = shift_reg ^ 0x8c ;
-		}
-	}
-	if (shift_reg) SL_ERR("CRC=%x FAIL %'-+B\n", shift_reg, buflen, buf) ;
-	return shift_reg ? 0 : 1 ;
+	uint8_t Crc = OWCrc8(0, buf, buflen) ;
+	IF_PRINT(debugCRC && Crc, "CRC=%x FAIL %'-+B\n", Crc, buflen, buf) ;
+	return Crc ? 0 : 1 ;								// failures counted by caller (owbiEV_CRC)
 }
 
 /**
@@ -358,58 +482,113 @@ uint8_t	OWCheckCRC(uint8_t * buf, uint8_t buflen) {
  * @param	data
  * @return				Returns current crc8 value
  */
-uint8_t	OWCalcCRC8(owdi_t * psOW, uint8_t data) {
-	psOW->crc8 = psOW->crc8 ^ data;
-	for (int i = 0; i < CHAR_BIT; ++i) {
-		if (psOW->crc8 & 1)	psOW->crc8 = (psOW->crc8 >> 1) ^ 0x8c;
-		else 				psOW->crc8 = (psOW->crc8 >> 1);
-	}
-	return psOW->crc8;
-}
+uint8_t	OWCalcCRC8(owdi_t * psOW, uint8_t data) { return psOW->crc8 = OWCrc8Byte(psOW->crc8, data) ; }
 
 /**
  * OWReadROM() - Check PPD, send command and loop for 8byte read
  * @brief	To be used if only a single device on a bus and the ROM ID must be read
  * 			Probably will fail if more than 1 device on the bus
  * @return	erFAILURE or CRC byte
+ * @note	On CRC or I2C failure the bus is reset and the ROM read again, bounded by ds248xRecover()
  */
 int	OWReadROM(owdi_t * psOW) {
-	OWWriteByte(psOW, OW_CMD_READROM) ;
-	psOW->ROM.Value = 0ULL ;
 	int	iRV = 0 ;
-	do {
+	for (int Try = 0; ; ++Try) {
+		OWWriteByte(psOW, OW_CMD_READROM) ;
+		IF_OWRESUME_CLEAR(psOW) ;
+		psOW->ROM.Value = 0ULL ;
 		for (int i = 0; i < sizeof(ow_rom_t); ++i) {
 			iRV = OWReadByte(psOW) ;					// read 8x bytes ie ROM FAM+ID+CRC
 			LT_GOTO(iRV, erSUCCESS, exit) ;
 			psOW->ROM.HexChars[i] = iRV ;
 		}
-	} while (OWCheckCRC(psOW->ROM.HexChars, sizeof(ow_rom_t)) == 0) ;
+		ds248x_t * psDS248X = ds248xDEV(psOW->DevNum) ;
+		if (psDS248X->OWErr == 0 && OWCheckCRC(psOW->ROM.HexChars, sizeof(ow_rom_t))) break ;
+		if (ds248xRecover(psDS248X, psDS248X->OWErr ? psDS248X->ErrCls : ds248xERR_CRC, Try) == 0 || OWReset(psOW) == 0) {
+			iRV = erFAILURE ;
+			break ;
+		}
+	}
 exit:
 	return iRV ;
 }
 
 /**
  * OWAddress() - Addresses a single or all devices on the 1-wire bus
- * @param nAddrMethod	use OW_CMD_MATCHROM to select a single
- *						device or OW_CMD_SKIPROM to select all
+ * @param nAddrMethod	use OW_CMD_MATCHROM to select a single device, OW_CMD_SKIPROM
+ *						to select all or OW_CMD_ODSKIPROM to select all overdrive capable
+ *						devices, switching them to overdrive after a standard speed reset
  * @note	Timing is 163/860 (SKIPROM) or 1447/7740 (MATCHROM)
+ * @note	MATCHROM of the device last matched on the bus becomes Resume (1 instead of 9 bytes)
+ *			if the family supports it, ROM commands in ds248xAsyncSubmit() jobs are not
+ *			tracked and must not be mixed with Resume capable devices on the same bus
  */
 void OWAddress(owdi_t * psOW, uint8_t nAddrMethod) {
+#if		(owBUILD_RESUME > 0)
+	// only a ROM command directly after reset selects or changes RC flags
+	bool Track = ds248xDEV(psOW->DevNum)->PostRst ;
+	uint64_t RCrom = Track ? OWP_BusResumeGet(OWP_BusP2L(psOW)) : 0ULL ;
+#endif
+#if		(owBUILD_OVERDRIVE > 0)
+	ds248x_t * psDS248X = ds248xDEV(psOW->DevNum) ;
+	bool ODskip = (nAddrMethod == OW_CMD_ODSKIPROM) ;
+	if ((ODskip || (psOW->OD && nAddrMethod == OW_CMD_MATCHROM)) && psDS248X->OWS == owSPEED_STANDARD && psDS248X->PostRst) {
+		// promote, command at standard speed after reset, ROM and all further traffic at overdrive
+		OWWriteByte(psOW, ODskip ? OW_CMD_ODSKIPROM : OW_CMD_ODMATCHROM) ;
+		ds248xOWSpeed(psDS248X, owSPEED_ODRIVE) ;
+		OWP_BusODSet(OWP_BusP2L(psOW), ODskip ? owbiOD_ALL : psOW->ROM.Value) ;
+	} else if (ODskip) {
+		OWWriteByte(psOW, OW_CMD_SKIPROM) ;				// already at overdrive, standard devices deaf
+	} else
+#endif
+#if		(owBUILD_RESUME > 0)
+	if (nAddrMethod == OW_CMD_MATCHROM && RCrom && RCrom == psOW->ROM.Value &&
+		(OWFamilyCaps(psOW->ROM.Family) & owCAP_RESUME)) {
+		// same device as last Match ROM on this bus and nothing cleared its RC flag since
+		OWWriteByte(psOW, OW_CMD_RESUME) ;
+		OWP_BusEvent(OWP_BusP2L(psOW), owbiEV_RESUME) ;
+		return ;
+	} else
+#endif
 	OWWriteByte(psOW, nAddrMethod) ;
 	if (nAddrMethod == OW_CMD_MATCHROM) {
 		for (int i = 0; i < sizeof(ow_rom_t); OWWriteByte(psOW, psOW->ROM.HexChars[i++])) ;
 	}
+#if		(owBUILD_RESUME > 0)
+	// a failed transfer leaves the RC flags unknown
+	if (Track) OWP_BusResumeSet(OWP_BusP2L(psOW), (nAddrMethod == OW_CMD_MATCHROM && ds248xDEV(psOW->DevNum)->OWErr == 0) ? psOW->ROM.Value : 0ULL) ;
+#endif
 }
 
-int OWCommand(owdi_t * psOW, uint8_t Command, bool All) {
+/**
+ * @brief	Address one (MATCHROM) or all (SKIPROM) devices then write Command
+ * @param	Power - strong pullup after Command, parasitic powered convert/copy
+ * @return	1 if written (and strong pullup active if requested) else 0
+ */
+int OWCommand(owdi_t * psOW, uint8_t Command, bool All, bool Power) {
 	OWAddress(psOW, All ? OW_CMD_SKIPROM : OW_CMD_MATCHROM) ;
+	if (Power) return OWWriteBytePower(psOW, Command) ;
 	OWWriteByte(psOW, Command) ;
 	return 1 ;
 }
 
-int OWResetCommand(owdi_t * psOW, uint8_t Command, bool All) {
-	if (OWReset(psOW) == 0) return 0 ;
-	return OWCommand(psOW, Command, All) ;
+/**
+ * @brief	Reset, address & write Command as one transaction
+ * @return	1 if written (and strong pullup active if requested) else 0
+ * @note	A failed I2C transaction repeats the lot from the reset, bounded by ds248xRecover()
+ */
+int OWResetCommand(owdi_t * psOW, uint8_t Command, bool All, bool Power) {
+	ds248x_t * psDS248X = ds248xDEV(psOW->DevNum) ;
+	for (int Try = 0; ; ++Try) {
+#if		(owBUILD_OVERDRIVE > 0)
+		if (OWResetSpeed(psOW, All ? 0 : psOW->OD) == 0) return 0 ;	// SKIPROM must reach all devices
+#else
+		if (OWReset(psOW) == 0) return 0 ;
+#endif
+		int iRV = OWCommand(psOW, Command, All, Power) ;
+		if (psDS248X->OWErr == 0) return iRV ;
+		if (ds248xRecover(psDS248X, psDS248X->ErrCls, Try) == 0) return 0 ;
+	}
 }
 
 /**
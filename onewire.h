@@ -6,6 +6,7 @@
 
 #include	"hal_i2c.h"
 #include	"ds248x.h"
+#include	"onewire_crc.h"
 
 #include	<stddef.h>
 #include	<stdbool.h>
@@ -34,6 +35,11 @@ extern "C" {
 
 #define	ds18x20BARE_BONES			1
 
+#define	owBUILD_OVERDRIVE			1					// address capable devices at overdrive speed
+#define	owBUILD_RESUME				1					// re-address last matched device with Resume ROM
+
+#define	owDELTA_TAIL				8					// bits checked below last known branch, 1 in 2^n added devices missed
+
 // ################################## Generic 1-Wire Commands ######################################
 
 #define OW_CMD_SEARCHROM     		0xF0
@@ -41,6 +47,9 @@ extern "C" {
 #define OW_CMD_SKIPROM       		0xCC
 #define OW_CMD_MATCHROM      		0x55
 #define OW_CMD_READROM       		0x33
+#define OW_CMD_ODSKIPROM     		0x3C				// capable devices to overdrive
+#define OW_CMD_ODMATCHROM    		0x69				// ROM sent at overdrive speed
+#define OW_CMD_RESUME        		0xA5				// re-select device with RC flag set by last Match ROM
 
 // ##################################### iButton Family Codes #####################################
 
@@ -83,6 +92,11 @@ enum { owSPEED_STANDARD, owSPEED_ODRIVE	} ;
 enum { owPOWER_STANDARD, owPOWER_STRONG	} ;
 enum { owFAM28_RES9B, owFAM28_RES10B, owFAM28_RES11B, owFAM28_RES12B } ;
 
+enum {													// family capabilities
+	owCAP_OD		= (1 << 0),							// Overdrive Skip/Match ROM
+	owCAP_RESUME	= (1 << 1),							// Resume ROM (0xA5)
+} ;
+
 // ######################################### Structures ############################################
 
 typedef	struct __attribute__((packed)) {
@@ -93,7 +107,7 @@ typedef	struct __attribute__((packed)) {
 	uint8_t 	LDF		: 1 ;						// Last Device Flag
 	uint8_t		DevNum	: 2 ;						// index into 1W DevInfo table
 	uint8_t		PhyBus	: 3 ;
-	uint8_t		OD		: 1 ;
+	uint8_t		OD		: 1 ;						// address at overdrive speed
 	uint8_t		Spare	: 1 ;
 } owdi_t ;
 DUMB_STATIC_ASSERT(sizeof(owdi_t) == 12) ;
@@ -112,6 +126,7 @@ int		OWLevel(owdi_t * psOW, bool level) ;
 uint8_t	OWCheckCRC(uint8_t * buf, uint8_t buflen) ;
 uint8_t	OWCalcCRC8(owdi_t * psOW, uint8_t data) ;
 uint8_t	OWSearchTriplet(owdi_t * psOW, uint8_t search_direction) ;
+uint8_t	OWFamilyCaps(uint8_t Family) ;
 
 // ################################## Bit/Byte Read/Write ##########################################
 
@@ -135,8 +150,16 @@ int	OWSearch(owdi_t * psOW, bool alarm_only) ;
 int OWFirst(owdi_t * psOW, bool alarm_only) ;
 int OWNext(owdi_t * psOW, bool alarm_only) ;
 int	OWVerify(owdi_t * psOW) ;
-int OWCommand(owdi_t * psOW, uint8_t Command, bool All) ;
-int OWResetCommand(owdi_t * psOW, uint8_t Command, bool All) ;
+int	OWRomCompare(const ow_rom_t * psA, const ow_rom_t * psB) ;
+int	OWSearchAll(owdi_t * psOW, ow_rom_t * paROM, int Size, const uint8_t * paFam, int FamNum, bool alarm_only) ;
+/**
+ * Check the (selected) bus against paKnown[Known], sorted as returned by OWSearchAll().
+ * Returns 0 if unchanged, else the number of devices added plus missing with the current
+ * set in paROM[*pCount] (as per OWSearchAll())
+ */
+int	OWSearchDelta(owdi_t * psOW, const ow_rom_t * paKnown, int Known, ow_rom_t * paROM, int Size, int * pCount) ;
+int OWCommand(owdi_t * psOW, uint8_t Command, bool All, bool Power) ;
+int OWResetCommand(owdi_t * psOW, uint8_t Command, bool All, bool Power) ;
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * onewire_crc.h - Dallas/Maxim 1-Wire CRC8 & CRC16
+ */
+
+#pragma		once
+
+#include	<stdint.h>
+#include	<stdbool.h>
+#include	<stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ############################################# Macros ############################################
+
+#define	owCRC_BIT					0					// no table, 8 shifts per byte
+#define	owCRC_NIBBLE				1					// 2x16 byte tables, 2 lookups per byte
+#define	owCRC_TABLE					2					// 256 entry table, 1 lookup per byte
+#define	owCRC_SLICE4				3					// 4x256 entry tables, 4 bytes per step (CRC16 only)
+
+#define	owCRC8_MODE					owCRC_TABLE			// used by OWCrc8() & OWCrc8Byte()
+#define	owCRC16_MODE				owCRC_SLICE4		// used by OWCrc16()
+
+#define	owCRC16_RESIDUE				0xB001				// CRC16 over data + inverted CRC as sent
+
+#ifndef	owBUILD_CRC_BENCH								// host build (test/) sets it on the command line
+	#define	owBUILD_CRC_BENCH		0					// OWCrcBenchmark()
+#endif
+
+// ###################################### Public functions #########################################
+
+/* All functions are incremental, start with Crc = 0 and pass the previous result to continue.
+ * CRC8 over data including the CRC byte is 0 if correct */
+uint8_t	OWCrc8Bit(uint8_t Crc, const uint8_t * pBuf, size_t Len) ;
+uint8_t	OWCrc8Nibble(uint8_t Crc, const uint8_t * pBuf, size_t Len) ;
+uint8_t	OWCrc8Table(uint8_t Crc, const uint8_t * pBuf, size_t Len) ;
+uint8_t	OWCrc8(uint8_t Crc, const uint8_t * pBuf, size_t Len) ;
+uint8_t	OWCrc8Byte(uint8_t Crc, uint8_t Byte) ;
+
+/* CRC16 (x^16 + x^15 + x^2 + 1, reflected) as used by DS2431/DS2408/DS28EC20 memory & PIO
+ * commands, devices send the CRC inverted, LSB first */
+uint16_t OWCrc16Bit(uint16_t Crc, const uint8_t * pBuf, size_t Len) ;
+uint16_t OWCrc16Table(uint16_t Crc, const uint8_t * pBuf, size_t Len) ;
+uint16_t OWCrc16Slice4(uint16_t Crc, const uint8_t * pBuf, size_t Len) ;
+uint16_t OWCrc16(uint16_t Crc, const uint8_t * pBuf, size_t Len) ;
+/**
+ * Check Len bytes of data followed by the 2 byte inverted CRC as received from the device,
+ * Crc is the CRC16 of any command/address bytes preceding the data (0 if none)
+ */
+bool	OWCrc16Check(uint16_t Crc, const uint8_t * pBuf, size_t Len) ;
+
+/**
+ * Verify all variants agree then report pS per byte for ROM (8), scratchpad (9) and
+ * memory page (32 + 2) sized buffers
+ */
+void	OWCrcBenchmark(int Loops) ;
+
+#ifdef __cplusplus
+}
+#endif
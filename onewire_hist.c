@@ -0,0 +1,94 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * onewire_hist.c - fixed bucket latency histograms
+ */
+
+#include	"hal_variables.h"
+#include	"onewire_hist.h"
+#include	"ds248x.h"
+#include	"printfx.h"
+
+#if		(ds248xBUILD_EMUL > 0)
+	#include	"ds248x_emul.h"
+#else
+	#include	"esp_timer.h"
+#endif
+
+// ################################ Local ONLY utility functions ###################################
+
+#define	owHIST_SUB_BITS				__builtin_ctz(owHIST_SUB)
+DUMB_STATIC_ASSERT((owHIST_SUB & (owHIST_SUB - 1)) == 0) ;			// shift derived from owHIST_SUB
+
+/* Below owHIST_SUB one bucket per uS, above that each power of 2 split into owHIST_SUB linear
+ * buckets, ie 4, 5, 6, 7, 8, 10, 12, 14, 16, 20 ... for owHIST_SUB = 4 */
+static int OWHistIndex(uint32_t uS) {
+	if (uS < owHIST_SUB) return uS ;
+	int Shift = (31 - __builtin_clz(uS)) - owHIST_SUB_BITS ;	// bits below the sub-bucket bits
+	int Idx = ((Shift + 1) * owHIST_SUB) + ((uS >> Shift) & (owHIST_SUB - 1)) ;
+	return (Idx < owHIST_BUCKETS) ? Idx : (owHIST_BUCKETS - 1) ;
+}
+
+static uint32_t OWHistUpper(int Idx) {
+	if (Idx < owHIST_SUB) return Idx ;
+	int Shift = (Idx / owHIST_SUB) - 1 ;
+	return (((owHIST_SUB + 1 + (Idx % owHIST_SUB)) << Shift) - 1) ;
+}
+
+// ###################################### Public functions #########################################
+
+uint32_t OWHistMicros(void) {
+#if		(ds248xBUILD_EMUL > 0)
+	return (uint32_t) ds248xEmulMicros() ;				// virtual bus clock
+#else
+	return (uint32_t) esp_timer_get_time() ;
+#endif
+}
+
+void	OWHistAdd(owhist_t * psH, uint32_t uS) {
+	int Idx = OWHistIndex(uS) ;
+	__atomic_fetch_add(&psH->Count[Idx], 1, __ATOMIC_RELAXED) ;
+	uint32_t Max = __atomic_load_n(&psH->Max, __ATOMIC_RELAXED) ;
+	while (uS > Max && !__atomic_compare_exchange_n(&psH->Max, &Max, uS, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) ;
+}
+
+void	OWHistSnapshot(owhist_t * psDst, owhist_t * psSrc, bool Reset) {
+	for (int i = 0; i < owHIST_BUCKETS; ++i) {
+		uint32_t Count = Reset ? __atomic_exchange_n(&psSrc->Count[i], 0, __ATOMIC_RELAXED)
+							   : __atomic_load_n(&psSrc->Count[i], __ATOMIC_RELAXED) ;
+		if (psDst) psDst->Count[i] = Count ;
+	}
+	uint32_t Max = Reset ? __atomic_exchange_n(&psSrc->Max, 0, __ATOMIC_RELAXED)
+						 : __atomic_load_n(&psSrc->Max, __ATOMIC_RELAXED) ;
+	if (psDst) psDst->Max = Max ;
+}
+
+uint32_t OWHistTotal(owhist_t * psH) {
+	uint32_t Total = 0 ;
+	for (int i = 0; i < owHIST_BUCKETS; Total += psH->Count[i++]) ;
+	return Total ;
+}
+
+uint32_t OWHistPercentile(owhist_t * psH, int Pct) {
+	uint32_t Total = OWHistTotal(psH) ;
+	if (Total == 0) return 0 ;
+	uint32_t Rank = ((Total * Pct) + 99) / 100 ;		// 1 based rank of the sample
+	if (Rank == 0) Rank = 1 ;
+	uint32_t Sum = 0 ;
+	for (int i = 0; i < owHIST_BUCKETS - 1; ++i) {
+		Sum += psH->Count[i] ;
+		if (Sum >= Rank) return (OWHistUpper(i) < psH->Max) ? OWHistUpper(i) : psH->Max ;
+	}
+	return psH->Max ;
+}
+
+void	OWHistReport(char const * pcName, owhist_t * psH) {
+	owhist_t sH ;
+	OWHistSnapshot(&sH, psH, 0) ;
+	uint32_t Total = OWHistTotal(&sH) ;
+	if (Total == 0) return ;
+	printfx("%-8s n=%-6u p50=%-6u p90=%-6u p99=%-6u max=%uuS\n", pcName, Total,
+		OWHistPercentile(&sH, 50), OWHistPercentile(&sH, 90), OWHistPercentile(&sH, 99), sH.Max) ;
+}
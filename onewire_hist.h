@@ -0,0 +1,60 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * onewire_hist.h - fixed bucket latency histograms
+ */
+
+#pragma		once
+
+#include	<stdint.h>
+#include	<stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ############################################# Macros ############################################
+
+#define	owBUILD_HIST				1					// always on latency histograms
+#define	owHIST_SUB					4					// linear buckets per power of 2, ~12% resolution
+#define	owHIST_BUCKETS				80					// 0uS -> ~2S, last bucket open ended
+
+#if		(owBUILD_HIST > 0)
+	#define	IF_OWHIST_START(t)			uint32_t t = OWHistMicros()
+	#define	IF_OWHIST_STOP(psH, t)		OWHistAdd(psH, OWHistMicros() - t)
+#else
+	#define	IF_OWHIST_START(t)
+	#define	IF_OWHIST_STOP(psH, t)
+#endif
+
+// ######################################### Structures ############################################
+
+/* Updated lock free (relaxed atomics) from any task, buckets are individually consistent.
+ * Must be naturally aligned, do not embed in packed structures */
+typedef struct owhist_t {
+	uint32_t			Count[owHIST_BUCKETS] ;
+	uint32_t			Max ;							// uS
+} owhist_t ;
+
+// ###################################### Public functions #########################################
+
+uint32_t OWHistMicros(void) ;
+void	OWHistAdd(owhist_t * psH, uint32_t uS) ;
+/**
+ * Copy psSrc to psDst, if Reset each bucket is cleared as it is copied so no sample is
+ * lost or counted twice. psDst may be NULL to only reset
+ */
+void	OWHistSnapshot(owhist_t * psDst, owhist_t * psSrc, bool Reset) ;
+uint32_t OWHistTotal(owhist_t * psH) ;
+/**
+ * Upper bound (uS) of the bucket holding the Pct (0 -> 100) percentile sample,
+ * Max for the highest bucket, 0 if no samples
+ */
+uint32_t OWHistPercentile(owhist_t * psH, int Pct) ;
+void	OWHistReport(char const * pcName, owhist_t * psH) ;
+
+#ifdef __cplusplus
+}
+#endif
@@ -37,14 +37,35 @@
 
 // ###################################### General macros ###########################################
 
+#define	owpJOB_GROW					8					// found devices array increment
+#define	owpDEV_GROW					8					// platform device list increment
+
+
+// ######################################### Structures ############################################
+
+#if		(owPLATFORM_PARALLEL > 0)
+typedef struct owp_job_t {								// per DS248x job, results merged by caller
+	ds248x_req_t	sReq ;
+	owdi_t *		psaOW ;								// devices found, in bus & search order
+	uint16_t		Count ;
+	uint16_t		Size ;
+	uint8_t			Family ;
+} owp_job_t ;
+#endif
 
 // ################################# Platform related variables ####################################
 
 owbi_t * psaOWBI = NULL ;
+#if		(ds248xBUILD_ASYNC > 0)
+static ds248x_req_t * psaOWP_SampleReq = NULL ;		// per DS248x, posted by OWP_TempReadSample()
+#endif
 ow_flags_t	OWflags ;
+owhist_t	OWP_Hist[owpH_NUM] ;
 
 static uint8_t	OWP_NumBus = 0 ;
-static uint8_t	OWP_NumDev = 0 ;
+static uint16_t	OWP_NumDev = 0 ;
+static uint16_t	OWP_DevSize = 0 ;
+static owdi_t *	psaOWP_Dev = NULL ;						// supported devices found at boot, bus & search order
 
 // ################################# Application support functions #################################
 
@@ -64,7 +85,7 @@ void OWP_BusL2P(owdi_t * psOW, uint8_t LogBus) {
 	memset(psOW, 0, sizeof(owdi_t)) ;
 #if		(halHAS_DS248X > 0)
 	for (int i = 0; i < ds248xCount; ++i) {
-		ds248x_t * psDS248X = &psaDS248X[i] ;
+		ds248x_t * psDS248X = ds248xDEV(i) ;
 		IF_TRACK(debugMAPPING, "Read: Ch=%d  Idx=%d  N=%d  L=%d  H=%d\n", LogBus, i, psDS248X->NumChan, psDS248X->Lo, psDS248X->Hi) ;
 		if (psDS248X->NumChan && INRANGE(psDS248X->Lo, LogBus, psDS248X->Hi, uint8_t)) {
 			psOW->DevNum	= i ;
@@ -80,7 +101,7 @@ void OWP_BusL2P(owdi_t * psOW, uint8_t LogBus) {
 
 int	OWP_BusP2L(owdi_t * psOW) {
 	IF_myASSERT(debugPARAM, halCONFIG_inSRAM(psaDS248X) && halCONFIG_inSRAM(psOW)) ;
-	ds248x_t * psDS248X = &psaDS248X[psOW->DevNum] ;
+	ds248x_t * psDS248X = ds248xDEV(psOW->DevNum) ;
 	return (psDS248X->Lo + psOW->PhyBus) ;
 }
 
@@ -92,7 +113,7 @@ int	OWP_BusP2L(owdi_t * psOW) {
  */
 int	 OWP_BusSelect(owdi_t * psOW) {
 	IF_SYSTIMER_START(debugTIMING,stOW1) ;
-	int iRV = ds248xBusSelect(&psaDS248X[psOW->DevNum], psOW->PhyBus) ;
+	int iRV = ds248xBusSelect(ds248xDEV(psOW->DevNum), psOW->PhyBus) ;
 	IF_SYSTIMER_STOP(debugTIMING,stOW1) ;
 	return iRV ;
 }
@@ -107,13 +128,51 @@ int	 OWP_BusSelect(owdi_t * psOW) {
 int	OWP_BusSelectAndAddress(owdi_t * psOW, uint8_t u8AddrMethod) {
 	if (OWP_BusSelect(psOW) == 0) return 0 ;
 	IF_SYSTIMER_START(debugTIMING,stOW2) ;
-	if (psOW->OD && (OWSpeed(psOW, owSPEED_ODRIVE) != owSPEED_ODRIVE)) SL_ERR("Overdrive failed!!!") ;
-	OWAddress(psOW, u8AddrMethod) ;
+	OWAddress(psOW, u8AddrMethod) ;						// switches speed if psOW->OD
 	IF_SYSTIMER_STOP(debugTIMING,stOW2) ;
 	return 1 ;
 }
 
-void OWP_BusRelease(owdi_t * psOW) { ds248xBusRelease(&psaDS248X[psOW->DevNum]) ; }
+void OWP_BusRelease(owdi_t * psOW) { ds248xBusRelease(ds248xDEV(psOW->DevNum)) ; }
+
+/**
+ * @brief	Count a bus health event (owbiEV_*), ignored before OWP_Config() allocated the buses
+ */
+void OWP_BusEvent(uint8_t LogBus, int Event) {
+	if (psaOWBI == NULL || LogBus >= OWP_NumBus) return ;
+	++psaOWBI[LogBus].Health[Event] ;
+	// devices may have lost power or the bridge its state, RC flag & overdrive no longer trusted
+	if (Event == owbiEV_NOPPD || Event == owbiEV_SD || Event == owbiEV_DEVRST) {
+		psaOWBI[LogBus].RCrom.Value = 0ULL ;
+		psaOWBI[LogBus].ODrom.Value = 0ULL ;
+	}
+}
+
+/**
+ * @brief	Device left with its RC flag set by the last Match ROM on the bus, 0 = none
+ * @note	Accessed by value, RCrom is a member of the packed owbi_t
+ */
+uint64_t OWP_BusResumeGet(uint8_t LogBus) {
+	return (psaOWBI == NULL || LogBus >= OWP_NumBus) ? 0ULL : psaOWBI[LogBus].RCrom.Value ;
+}
+
+void OWP_BusResumeSet(uint8_t LogBus, uint64_t Value) {
+	if (psaOWBI == NULL || LogBus >= OWP_NumBus) return ;
+	psaOWBI[LogBus].RCrom.Value = Value ;
+}
+
+/**
+ * @brief	Device switched to overdrive by Overdrive Match ROM since the last standard speed
+ *			reset, owbiOD_ALL after Overdrive Skip ROM, 0 = none
+ */
+uint64_t OWP_BusODGet(uint8_t LogBus) {
+	return (psaOWBI == NULL || LogBus >= OWP_NumBus) ? 0ULL : psaOWBI[LogBus].ODrom.Value ;
+}
+
+void OWP_BusODSet(uint8_t LogBus, uint64_t Value) {
+	if (psaOWBI == NULL || LogBus >= OWP_NumBus) return ;
+	psaOWBI[LogBus].ODrom.Value = Value ;
+}
 
 // #################################### Handler functions ##########################################
 
@@ -181,6 +240,20 @@ int	OWP_Count_CB(flagmask_t FlagCount, owdi_t * psOW) {
 	return 0 ;
 }
 
+/**
+ * @brief	Count a supported device and append it to the platform device list
+ */
+static int OWP_Collect_CB(flagmask_t FlagCount, owdi_t * psOW) {
+	if (OWP_Count_CB(FlagCount, psOW) == 0) return 0 ;
+	if (OWP_NumDev == OWP_DevSize) {
+		OWP_DevSize	+= owpDEV_GROW ;
+		psaOWP_Dev	= realloc(psaOWP_Dev, OWP_DevSize * sizeof(owdi_t)) ;
+		IF_myASSERT(debugRESULT, halCONFIG_inSRAM(psaOWP_Dev)) ;
+	}
+	memcpy(&psaOWP_Dev[OWP_NumDev++], psOW, sizeof(owdi_t)) ;
+	return 1 ;
+}
+
 int	OWP_ScanAlarms_CB(flagmask_t sFM, owdi_t * psOW) {
 	sFM.bNL	= 1 ;
 	sFM.bRT	= 1 ;
@@ -197,8 +270,92 @@ int	OWP_ScanAlarms_CB(flagmask_t sFM, owdi_t * psOW) {
  * @param	psOW
  * @return	number of matching ROM's found (>= 0) or an error code (< 0)
  */
+#if		(owPLATFORM_PARALLEL > 0)
+/**
+ * @brief	Run Job for every DS248x device on its own worker, wait for all to complete
+ * @note	Jobs not accepted by a worker (queue full/not running) are run by the caller
+ */
+static void OWP_RunJobs(ds248x_cb_t Job, owp_job_t * psaJob) {
+	int Submitted = 0 ;
+	for (int i = 0; i < ds248xCount; ++i) {
+		ds248x_req_t * psReq = &psaJob[i].sReq ;
+		psReq->cb		= Job ;
+		psReq->pvArg	= &psaJob[i] ;
+		psReq->Cmd		= ds248xREQ_EXEC ;
+		if (ds248xAsyncSubmit(ds248xDEV(i), psReq) == erSUCCESS) ++Submitted ;
+		else Job(ds248xDEV(i), psReq) ;
+	}
+	while (Submitted--) ulTaskNotifyTake(pdFALSE, portMAX_DELAY) ;
+}
+
+/**
+ * @brief	Search all buses of one DS248x, collecting [Family] devices found
+ */
+static void OWP_ScanJob(ds248x_t * psDS248X, ds248x_req_t * psReq) {
+	owp_job_t * psJob = psReq->pvArg ;
+	owdi_t	sOW ;
+	for (int LogBus = psDS248X->Lo; LogBus <= psDS248X->Hi; ++LogBus) {
+		OWP_BusL2P(&sOW, LogBus) ;
+		if (OWP_BusSelect(&sOW) == 0) continue ;
+		int iRV ;
+		if (psJob->Family) {
+			OWTargetSetup(&sOW, psJob->Family) ;
+			iRV = OWSearch(&sOW, 0) ;
+		} else {
+			iRV = OWFirst(&sOW, 0) ;
+		}
+		while (iRV && (psJob->Family == 0 || sOW.ROM.Family == psJob->Family)) {
+			if (psJob->Count == psJob->Size) {
+				psJob->Size		+= owpJOB_GROW ;
+				psJob->psaOW	= realloc(psJob->psaOW, psJob->Size * sizeof(owdi_t)) ;
+				IF_myASSERT(debugRESULT, halCONFIG_inSRAM(psJob->psaOW)) ;
+			}
+			memcpy(&psJob->psaOW[psJob->Count++], &sOW, sizeof(owdi_t)) ;
+			iRV = OWNext(&sOW, 0) ;
+		}
+		OWP_BusRelease(&sOW) ;
+	}
+}
+
+/**
+ * @brief	Search all DS248x devices concurrently then call the handler for each device found,
+ *			in the same order and with the bus selected, as the sequential scan would
+ */
+static int OWP_ScanParallel(uint8_t Family, int (* Handler)(flagmask_t, owdi_t *),
+			int (* Handler2)(flagmask_t, void *, owdi_t *), void * pVoid, owdi_t * psOW) {
+	owp_job_t * psaJob = malloc(ds248xCount * sizeof(owp_job_t)) ;
+	IF_myASSERT(debugRESULT, halCONFIG_inSRAM(psaJob)) ;
+	memset(psaJob, 0, ds248xCount * sizeof(owp_job_t)) ;
+	for (int i = 0; i < ds248xCount; psaJob[i++].Family = Family) ;
+	OWP_RunJobs(OWP_ScanJob, psaJob) ;
+
+	int	iRV = erSUCCESS ;
+	uint32_t uCount = 0 ;
+	for (int i = 0; i < ds248xCount && iRV >= erSUCCESS; ++i) {
+		for (int j = 0; j < psaJob[i].Count; ++j) {
+			memcpy(psOW, &psaJob[i].psaOW[j], sizeof(owdi_t)) ;
+			if (OWP_BusSelect(psOW) == 0) continue ;
+		#if	(owBUILD_OVERDRIVE > 0)
+			psOW->OD = (OWFamilyCaps(psOW->ROM.Family) & owCAP_OD) ? 1 : 0 ;
+		#endif
+			iRV = Handler ? Handler((flagmask_t) uCount, psOW) : Handler2((flagmask_t) uCount, pVoid, psOW) ;
+			OWP_BusRelease(psOW) ;
+			if (iRV < erSUCCESS) break ;
+			if (iRV > 0) ++uCount ;
+		}
+	}
+	for (int i = 0; i < ds248xCount; free(psaJob[i++].psaOW)) ;
+	free(psaJob) ;
+	IF_SL_ERR(iRV < erSUCCESS, "Handler error=%d", iRV) ;
+	return iRV < erSUCCESS ? iRV : uCount ;
+}
+#endif
+
 int	OWP_Scan(uint8_t Family, int (* Handler)(flagmask_t, owdi_t *), owdi_t * psOW) {
 	IF_myASSERT(debugPARAM, halCONFIG_inFLASH(Handler)) ;
+#if		(owPLATFORM_PARALLEL > 0)
+	if (ds248xNUM_DEV > 1) return OWP_ScanParallel(Family, Handler, NULL, NULL, psOW) ;
+#endif
 	int	iRV = erSUCCESS ;
 	uint32_t uCount = 0 ;
 	for (int LogBus = 0; LogBus < OWP_NumBus; ++LogBus) {
@@ -221,7 +378,13 @@ int	OWP_Scan(uint8_t Family, int (* Handler)(flagmask_t, owdi_t *), owdi_t * psO
 				IF_EXEC_2(debugSCANNER, OWP_Print1W_CB, makeMASKFLAG(0,0,0,0,0,0,0,0,0,0,0,0,LogBus), psOW) ;
 				iRV = OWCheckCRC(psOW->ROM.HexChars, sizeof(ow_rom_t)) ;
 				IF_myASSERT(debugRESULT, iRV == 1) ;
+			#if	(owBUILD_OVERDRIVE > 0)
+				psOW->OD = (OWFamilyCaps(psOW->ROM.Family) & owCAP_OD) ? 1 : 0 ;
+				iRV = Handler((flagmask_t) uCount, psOW) ;
+				psOW->OD = 0 ;							// continue search at standard speed
+			#else
 				iRV = Handler((flagmask_t) uCount, psOW) ;
+			#endif
 				if (iRV < erSUCCESS) break ;
 				if (iRV > 0) ++uCount ;
 				iRV = OWNext(psOW, 0) ;						// try to find next device (if any)
@@ -236,6 +399,9 @@ int	OWP_Scan(uint8_t Family, int (* Handler)(flagmask_t, owdi_t *), owdi_t * psO
 
 int	OWP_Scan2(uint8_t Family, int (* Handler)(flagmask_t, void *, owdi_t *), void * pVoid, owdi_t * psOW) {
 	IF_myASSERT(debugPARAM, halCONFIG_inFLASH(Handler)) ;
+#if		(owPLATFORM_PARALLEL > 0)
+	if (ds248xNUM_DEV > 1) return OWP_ScanParallel(Family, NULL, Handler, pVoid, psOW) ;
+#endif
 	int	iRV = erSUCCESS ;
 	uint32_t uCount = 0 ;
 	for (uint8_t LogBus = 0; LogBus < OWP_NumBus; ++LogBus) {
@@ -253,7 +419,13 @@ int	OWP_Scan2(uint8_t Family, int (* Handler)(flagmask_t, void *, owdi_t *), voi
 		while (iRV) {
 			iRV = OWCheckCRC(psOW->ROM.HexChars, sizeof(ow_rom_t)) ;
 			IF_myASSERT(debugRESULT, iRV == 1) ;
+		#if	(owBUILD_OVERDRIVE > 0)
+			psOW->OD = (OWFamilyCaps(psOW->ROM.Family) & owCAP_OD) ? 1 : 0 ;
+			iRV = Handler((flagmask_t) uCount, pVoid, psOW) ;
+			psOW->OD = 0 ;								// continue search at standard speed
+		#else
 			iRV = Handler((flagmask_t) uCount, pVoid, psOW) ;
+		#endif
 			if (iRV < erSUCCESS)  break ;
 			if (iRV > 0) ++uCount ;
 			iRV = OWNext(psOW, 0) ;						// try to find next device (if any)
@@ -265,6 +437,28 @@ int	OWP_Scan2(uint8_t Family, int (* Handler)(flagmask_t, void *, owdi_t *), voi
 	return iRV < erSUCCESS ? iRV : uCount ;
 }
 
+/**
+ * @brief	Call the handler, with the bus selected, for every [Family] device in the list built
+ *			by OWP_Config(), same order and counting as OWP_Scan() without searching the buses
+ * @return	number of devices handled (>= 0) or an error code (< 0)
+ */
+int	OWP_ScanList(uint8_t Family, int (* Handler)(flagmask_t, owdi_t *), owdi_t * psOW) {
+	IF_myASSERT(debugPARAM, halCONFIG_inFLASH(Handler)) ;
+	int	iRV = erSUCCESS ;
+	uint32_t uCount = 0 ;
+	for (int i = 0; i < OWP_NumDev; ++i) {
+		if (Family && psaOWP_Dev[i].ROM.Family != Family) continue ;
+		memcpy(psOW, &psaOWP_Dev[i], sizeof(owdi_t)) ;
+		if (OWP_BusSelect(psOW) == 0) continue ;
+		iRV = Handler((flagmask_t) uCount, psOW) ;
+		OWP_BusRelease(psOW) ;
+		if (iRV < erSUCCESS) break ;
+		if (iRV > 0) ++uCount ;
+	}
+	IF_SL_ERR(iRV < erSUCCESS, "Handler error=%d", iRV) ;
+	return iRV < erSUCCESS ? iRV : uCount ;
+}
+
 int	OWP_ScanAlarmsFamily(uint8_t Family) {
 	owdi_t	sOW ;
 	return OWP_Scan(Family, OWP_ScanAlarms_CB, &sOW) ;
@@ -284,7 +478,7 @@ int	OWP_Config(void) {
 	 * moving on to the next device (same type) or next technology */
 #if		(halHAS_DS248X > 0)
 	for (int i = 0; i < ds248xCount; ++i) {
-		ds248x_t * psDS248X = &psaDS248X[i] ;
+		ds248x_t * psDS248X = ds248xDEV(i) ;
 		psDS248X->Lo	= OWP_NumBus ;
 		psDS248X->Hi	= OWP_NumBus + psDS248X->NumChan - 1 ;
 		OWP_NumBus		+= psDS248X->NumChan ;
@@ -295,30 +489,60 @@ int	OWP_Config(void) {
 	if (OWP_NumBus) {
 		psaOWBI = malloc(OWP_NumBus * sizeof(owbi_t)) ;	// initialize the logical channel structures
 		memset(psaOWBI, 0, OWP_NumBus * sizeof(owbi_t)) ;
-		// enumerate any/all physical devices (possibly) (permanently) attached to individual channel(s)
+#if		(ds248xBUILD_ASYNC > 0)
+		psaOWP_SampleReq = calloc(ds248xCount, sizeof(ds248x_req_t)) ;
+		IF_myASSERT(debugRESULT, halCONFIG_inSRAM(psaOWP_SampleReq)) ;
+#endif
+		// single search of all channels, devices kept in psaOWP_Dev for per family configuration
 		owdi_t	sOW ;
-		int	iRV = OWP_Scan(0, OWP_Count_CB, &sOW) ;
-		if (iRV > 0) OWP_NumDev += iRV ;
+		int	iRV = OWP_Scan(0, OWP_Collect_CB, &sOW) ;
+		IF_SL_ERR(iRV < erSUCCESS, "Scan error=%d, %d devices collected", iRV, OWP_NumDev) ;
 
 #if		(halHAS_DS1990X > 0)
 		IF_SL_INFO(debugCONFIG && Family01Count, "DS1990x found %d devices", Family01Count) ;
 		iRV = ds1990xConfig() ;				// cannot enumerate, simple config
+		IF_SL_ERR(iRV < erSUCCESS, "DS1990x config error=%d", iRV) ;
 		IF_SYSTIMER_INIT(debugTIMING, stDS1990, stMILLIS, "DS1990", 10, 1000) ;
 #endif
 
 #if		(halHAS_DS18X20 > 0)
 		if (Fam10Count || Fam28Count) {
 			iRV = ds18x20Enumerate() ;		// enumerate & config individually
+			IF_SL_ERR(iRV < erSUCCESS, "DS18x20 enumerate error=%d", iRV) ;
 		}
 #endif
 	}
 	return OWP_NumDev ;
 }
 
+void OWP_ReportHealth(void) {
+	for (int LogBus = 0; LogBus < OWP_NumBus; ++LogBus) {
+		uint16_t pH[owbiEV_NUM] ;
+		memcpy(pH, psaOWBI[LogBus].Health, sizeof(pH)) ;	// packed, may be unaligned
+		printfx("OW ch=%d  Rst=%u NoPPD=%u SD=%u CRC=%u Abort=%u DevRst=%u Busy=%u Resume=%u (-%u bytes)\n", LogBus,
+			pH[owbiEV_RESET], pH[owbiEV_NOPPD], pH[owbiEV_SD], pH[owbiEV_CRC],
+			pH[owbiEV_ABORT], pH[owbiEV_DEVRST], pH[owbiEV_BUSY],
+			pH[owbiEV_RESUME], pH[owbiEV_RESUME] * (int) sizeof(ow_rom_t)) ;
+	}
+}
+
+/**
+ * @brief	Report latency percentiles of high level operations, optionally reset afterwards
+ */
+void OWP_ReportHist(bool Reset) {
+	static const char * const HistNames[owpH_NUM] = { "Search", "ReadSP", "TempAll" } ;
+	for (int H = 0; H < owpH_NUM; ++H) {
+		OWHistReport(HistNames[H], &OWP_Hist[H]) ;
+		if (Reset) OWHistSnapshot(NULL, &OWP_Hist[H], 1) ;
+	}
+}
+
 void OWP_Report(void) {
 	for (int LogBus = 0; LogBus < OWP_NumBus; ++LogBus) {
 		OWP_PrintChan_CB(makeMASKFLAG(0,1,0,0,0,0,0,0,0,0,0,0,LogBus), &psaOWBI[LogBus]) ;
 	}
+	OWP_ReportHealth() ;
+	OWP_ReportHist(0) ;
 #if 	(halHAS_DS248X > 0)
 	ds248xReportAll(1) ;
 #endif
@@ -366,9 +590,11 @@ void ds18x20SetSense(epw_t * psEWP, epw_t * psEWS) {
 float ds18x20GetTemperature(epw_t * psEWx) { return psEWx->var.val.x32.f32 ; }
 
 int	ds18x20EnumerateCB(flagmask_t sFM, owdi_t * psOW) {
-	ds18x20_t * psDS18X20 = &psaDS18X20[sFM.uCount] ;
+	if (psOW->ROM.Family != OWFAMILY_10 && psOW->ROM.Family != OWFAMILY_28) return 0 ;
+	int Idx = sFM.uCount ;
+	ds18x20_t * psDS18X20 = &psaDS18X20[Idx] ;
 	memcpy(&psDS18X20->sOW, psOW, sizeof(owdi_t)) ;
-	psDS18X20->Idx	= sFM.uCount ;
+	psDS18X20->Idx	= Idx ;
 
 	epw_t * psEWS = &psDS18X20->sEWx ;
 	memset(psEWS, 0, sizeof(epw_t)) ;
@@ -376,7 +602,7 @@ int	ds18x20EnumerateCB(flagmask_t sFM, owdi_t * psOW) {
 	psEWS->var.def.cv.vt	= vtVALUE ;
 	psEWS->var.def.cv.vs	= vs32B ;
 	psEWS->var.def.cv.vc	= 1 ;
-	psEWS->idx				= sFM.uCount ;
+	psEWS->idx				= Idx ;
 	psEWS->uri				= URI_DS18X20 ;
 	ds18x20Initialize(psDS18X20) ;
 
@@ -413,15 +639,8 @@ int	ds18x20Enumerate(void) {
 	memset(psaDS18X20, 0, Fam10_28Count * sizeof(ds18x20_t)) ;
 	IF_myASSERT(debugRESULT, halCONFIG_inSRAM(psaDS18X20)) ;
 	owdi_t	sOW ;
-	int	iRV = 0 ;
-	if (Fam10Count) {
-		iRV = OWP_Scan(OWFAMILY_10, ds18x20EnumerateCB, &sOW) ;
-		if (iRV > 0) ds18x20NumDev += iRV ;
-	}
-	if (Fam28Count) {
-		iRV = OWP_Scan(OWFAMILY_28, ds18x20EnumerateCB, &sOW) ;
-		if (iRV > 0) ds18x20NumDev += iRV ;
-	}
+	int	iRV = OWP_ScanList(0, ds18x20EnumerateCB, &sOW) ;	// DS18S20 & DS18B20 in bus order
+	if (iRV > 0) ds18x20NumDev += iRV ;
 	if (ds18x20NumDev == Fam10_28Count) {
 		iRV = ds18x20NumDev ;
 	} else {
@@ -431,31 +650,39 @@ int	ds18x20Enumerate(void) {
 	return iRV ;										// number of devices enumerated
 }
 
+/**
+ * @brief	Maximum conversion time, DS18S20 750mS, DS18B20 halved per bit below 12 ie 93.75mS at 9
+ * @param	All - SKIPROM convert, wait for the slowest sensor on the bus
+ * @return	ticks, rounded up plus 1 since vTaskDelay() may return up to a tick early
+ */
 TickType_t OWP_TempCalcDelay(ds18x20_t * psDS18X20, bool All) {
-	TickType_t tConvert = pdMS_TO_TICKS(ds18x20DELAY_CONVERT) ;
-	/* ONLY decrease delay if:
-	 * 	specific ROM is addressed AND and it is DS18B20 ; OR
-	 * 	ROM match skipped AND only DS18B20 devices on the bus */
-	owbi_t * psOWBI = psOWP_BusGetPointer(OWP_BusP2L(&psDS18X20->sOW)) ;
-	if ((All && (psOWBI->ds18s20 == 0))
-	|| ((All == 0) && (psDS18X20->sOW.ROM.Family == OWFAMILY_28))) {
-		tConvert /= (4 - psDS18X20->Res) ;
+	int LogBus = OWP_BusP2L(&psDS18X20->sOW) ;
+	int Res = (psDS18X20->sOW.ROM.Family == OWFAMILY_28) ? psDS18X20->Res : owFAM28_RES12B ;
+	if (All && psOWP_BusGetPointer(LogBus)->ds18s20) {
+		Res = owFAM28_RES12B ;
+	} else if (All) {
+		for (int i = 0; i < Fam10_28Count; ++i) {
+			ds18x20_t * psX = &psaDS18X20[i] ;
+			if (OWP_BusP2L(&psX->sOW) == LogBus && psX->Res > Res) Res = psX->Res ;
+		}
 	}
-	return tConvert ;
+	uint32_t mS = ((ds18x20DELAY_CONVERT * 1000U >> (owFAM28_RES12B - Res)) + 999U) / 1000U ;
+	return pdMS_TO_TICKS(mS + portTICK_PERIOD_MS - 1) + 1 ;
 }
 
 /**
  * @brief	Trigger convert (bus at a time) then read SP, normalise RAW value & persist in EPW
- * @param 	psEPW
- * @return
+ * @param 	DevNum - only sensors on this DS248x
+ * @param	ParaOnly - skip externally powered sensors, converted by OWP_TempConvertAll()
  */
-int	OWP_TempAllInOne(epw_t * psEWP) {
+static void OWP_TempAllInOneDev(uint8_t DevNum, bool ParaOnly) {
 	uint8_t	PrevBus = 0xFF ;
 	for (int i = 0; i < Fam10_28Count; ++i) {
 		ds18x20_t * psDS18X20 = &psaDS18X20[i] ;
+		if (psDS18X20->sOW.DevNum != DevNum || (ParaOnly && psDS18X20->Pwr)) continue ;
 		if (psDS18X20->sOW.PhyBus != PrevBus) {
 			if (OWP_BusSelectAndAddress(&psDS18X20->sOW, OW_CMD_SKIPROM) == 0) continue ;
-			if (OWResetCommand(&psDS18X20->sOW, DS18X20_CONVERT, 1) == 1) {
+			if (OWResetCommand(&psDS18X20->sOW, DS18X20_CONVERT, 1, !psDS18X20->Pwr) == 1) {
 				PrevBus = psDS18X20->sOW.PhyBus ;
 				vTaskDelay(OWP_TempCalcDelay(psDS18X20, 1)) ;
 				OWLevel(&psDS18X20->sOW, owPOWER_STANDARD) ;
@@ -468,14 +695,137 @@ int	OWP_TempAllInOne(epw_t * psEWP) {
 			OWP_BusRelease(&psDS18X20->sOW) ;
 		} else SL_ERR("Read/Convert failed") ;
 	}
+}
+
+#if		(owPLATFORM_CONVERT_ALL > 0)
+static uint64_t OWP_ConvBus = 0 ;						// logical buses converting
+#if		(owPLATFORM_CONVERT_POLL > 0)
+static TickType_t OWP_ConvLeft = 0 ;					// maximum conversion time left after first poll
+#endif
+
+/**
+ * @brief	SKIPROM+CONVERT back to back on every bus, all DS248x, with externally powered sensors
+ * @return	longest conversion delay of the buses started, 0 if none
+ * @note	ds18x20CheckPower() reads the bus wide (SKIPROM) power status, any parasitic sensor
+ *			marks all sensors on its bus parasitic. Those buses need the strong pullup for the
+ *			whole conversion and are left to OWP_TempAllInOneDev()
+ */
+static TickType_t OWP_TempConvertAll(void) {
+	TickType_t tConvert = 0 ;
+	uint64_t Done = 0 ;
+	IF_myASSERT(debugPARAM, OWP_NumBus <= 64) ;
+	for (int i = 0; i < Fam10_28Count; ++i) {
+		ds18x20_t * psDS18X20 = &psaDS18X20[i] ;
+		int LogBus = OWP_BusP2L(&psDS18X20->sOW) ;
+		if (psDS18X20->Pwr == 0 || (Done & (1ULL << LogBus))) continue ;
+		if (OWP_BusSelect(&psDS18X20->sOW) == 0) continue ;
+		if (OWResetCommand(&psDS18X20->sOW, DS18X20_CONVERT, 1, 0) == 1) {
+			Done |= (1ULL << LogBus) ;
+			TickType_t tBus = OWP_TempCalcDelay(psDS18X20, 1) ;
+			if (tBus > tConvert) tConvert = tBus ;
+		}
+		OWP_BusRelease(&psDS18X20->sOW) ;
+	}
+	OWP_ConvBus = Done ;
+	return tConvert ;
+}
+
+/**
+ * @brief	Read the externally powered sensors on one logical bus
+ */
+static void OWP_TempReadPowered(int LogBus) {
+	for (int i = 0; i < Fam10_28Count; ++i) {
+		ds18x20_t * psDS18X20 = &psaDS18X20[i] ;
+		if (psDS18X20->Pwr == 0 || OWP_BusP2L(&psDS18X20->sOW) != LogBus) continue ;
+		if (OWP_BusSelect(&psDS18X20->sOW) == 0) continue ;
+		if (ds18x20ReadSP(psDS18X20, 2) == 1) ds18x20ConvertTemperature(psDS18X20) ;
+		else SL_ERR("Read/Convert failed") ;
+		OWP_BusRelease(&psDS18X20->sOW) ;
+	}
+}
+
+/**
+ * @brief	Read the converted buses on this DS248x, then handle parasitic buses
+ * @note	With owPLATFORM_CONVERT_POLL each bus is read as soon as a read slot returns 1, all
+ *			powered sensors on it (SKIPROM, wired AND) have completed. Buses still converting
+ *			after the maximum conversion time are read anyway.
+ */
+static void OWP_TempReadDev(uint8_t DevNum) {
+	ds248x_t * psDS248X = ds248xDEV(DevNum) ;
+	uint64_t Pend = OWP_ConvBus & (((1ULL << psDS248X->NumChan) - 1ULL) << psDS248X->Lo) ;
+#if		(owPLATFORM_CONVERT_POLL > 0)
+	TickType_t tPoll = 0 ;
+#endif
+	while (Pend) {
+		for (int LogBus = psDS248X->Lo; LogBus <= psDS248X->Hi; ++LogBus) {
+			if ((Pend & (1ULL << LogBus)) == 0) continue ;
+#if		(owPLATFORM_CONVERT_POLL > 0)
+			owdi_t	sOW ;
+			OWP_BusL2P(&sOW, LogBus) ;
+			if (tPoll < OWP_ConvLeft && OWP_BusSelect(&sOW) == 1) {
+				uint8_t Done = OWReadBit(&sOW) ;
+				OWP_BusRelease(&sOW) ;
+				if (Done == 0) continue ;
+			}
+#endif
+			Pend &= ~(1ULL << LogBus) ;
+			OWP_TempReadPowered(LogBus) ;
+		}
+#if		(owPLATFORM_CONVERT_POLL > 0)
+		if (Pend) {
+			vTaskDelay(pdMS_TO_TICKS(ds18x20CONV_POLL_MS)) ;
+			tPoll += pdMS_TO_TICKS(ds18x20CONV_POLL_MS) ;
+		}
+#endif
+	}
+	OWP_TempAllInOneDev(DevNum, 1) ;
+}
+	#define	OWP_TempDev(DevNum)			OWP_TempReadDev(DevNum)
+#else
+	#define	OWP_TempDev(DevNum)			OWP_TempAllInOneDev(DevNum, 0)
+#endif
+
+#if		(owPLATFORM_PARALLEL > 0)
+static void OWP_TempJob(ds248x_t * psDS248X, ds248x_req_t * psReq) { OWP_TempDev(psDS248X->psI2C->DevIdx) ; }
+#endif
+
+/**
+ * @brief	Convert & read all sensors, DS248x devices concurrently if owPLATFORM_PARALLEL
+ * @param 	psEPW
+ * @return
+ * @note	With owPLATFORM_CONVERT_ALL all externally powered buses convert together, a cycle
+ *			takes one conversion period regardless of the number of buses
+ */
+int	OWP_TempAllInOne(epw_t * psEWP) {
+	IF_OWHIST_START(tH) ;
+#if		(owPLATFORM_CONVERT_POLL > 0)
+	TickType_t tConvert = OWP_TempConvertAll() ;
+	TickType_t tMin = (tConvert * ds18x20CONV_POLL_MIN) / 100 ;
+	OWP_ConvLeft = tConvert - tMin ;
+	if (tMin) vTaskDelay(tMin) ;
+#elif	(owPLATFORM_CONVERT_ALL > 0)
+	TickType_t tConvert = OWP_TempConvertAll() ;
+	if (tConvert) vTaskDelay(tConvert) ;
+#endif
+#if		(owPLATFORM_PARALLEL > 0)
+	if (ds248xNUM_DEV > 1) {
+		owp_job_t * psaJob = malloc(ds248xCount * sizeof(owp_job_t)) ;
+		IF_myASSERT(debugRESULT, halCONFIG_inSRAM(psaJob)) ;
+		memset(psaJob, 0, ds248xCount * sizeof(owp_job_t)) ;
+		OWP_RunJobs(OWP_TempJob, psaJob) ;
+		free(psaJob) ;
+	} else
+#endif
+	for (int i = 0; i < ds248xCount; ++i) OWP_TempDev(i) ;
+	IF_OWHIST_STOP(&OWP_Hist[owpH_TEMP], tH) ;
 	return erSUCCESS ;
 }
 
 int	OWP_TempStartBus(ds18x20_t * psDS18X20, int i) {
 	if (OWP_BusSelectAndAddress(&psDS18X20->sOW, OW_CMD_SKIPROM) == 1) {
-		OWResetCommand(&psDS18X20->sOW, DS18X20_CONVERT, 1) ;
-		vTimerSetTimerID(psaDS248X[psDS18X20->sOW.DevNum].tmr, (void *) i) ;
-		xTimerStart(psaDS248X[psDS18X20->sOW.DevNum].tmr, OWP_TempCalcDelay(psDS18X20, 1)) ;
+		OWResetCommand(&psDS18X20->sOW, DS18X20_CONVERT, 1, !psDS18X20->Pwr) ;
+		vTimerSetTimerID(ds248xDEV(psDS18X20->sOW.DevNum)->tmr, (void *) i) ;
+		xTimerStart(ds248xDEV(psDS18X20->sOW.DevNum)->tmr, OWP_TempCalcDelay(psDS18X20, 1)) ;
 		IF_TRACK(debugDS18X20, "Start Dev=%d Bus=%d", psDS18X20->sOW.DevNum, psDS18X20->sOW.PhyBus) ;
 		return 1 ;
 	}
@@ -494,8 +844,11 @@ int OWP_TempStartSample(epw_t * psEWx) {				// Stage 1 -
 	return erSUCCESS ;
 }
 
-void OWP_TempReadSample(TimerHandle_t pxHandle) {
-	int	ThisDev = (int) pvTimerGetTimerID(pxHandle) ;
+/**
+ * @brief	Read all sensors on the bus converted by OWP_TempStartBus(), then start the next bus
+ * @param	ThisDev - index of the first sensor on the bus
+ */
+static void OWP_TempReadBus(int ThisDev) {
 	ds18x20_t * psDS18X20 = &psaDS18X20[ThisDev] ;
 	OWLevel(&psDS18X20->sOW, owPOWER_STANDARD) ;		// Set OWLevel to standard
 	int i = ThisDev ;
@@ -520,3 +873,29 @@ void OWP_TempReadSample(TimerHandle_t pxHandle) {
 		// more sensors, same device and bus
 	} while  (i < Fam10_28Count) ;
 }
+
+#if		(ds248xBUILD_ASYNC > 0)
+static void OWP_TempReadJob(ds248x_t * psDS248X, ds248x_req_t * psReq) { OWP_TempReadBus((int) psReq->pvArg) ; }
+#endif
+
+/**
+ * @brief	Conversion timer expired, hand the reads to the DS248x worker
+ * @note	Runs in the timer service task, must not block on I2C. Each DS248x has one timer
+ *			and one request, re-armed only by the job itself, so the request is never in use.
+ *			Without a worker (or queue full) the reads are done here as before.
+ */
+void OWP_TempReadSample(TimerHandle_t pxHandle) {
+	int	ThisDev = (int) pvTimerGetTimerID(pxHandle) ;
+#if		(ds248xBUILD_ASYNC > 0)
+	uint8_t DevNum = psaDS18X20[ThisDev].sOW.DevNum ;
+	ds248x_req_t * psReq = &psaOWP_SampleReq[DevNum] ;
+	memset(psReq, 0, sizeof(ds248x_req_t)) ;
+	psReq->cb		= OWP_TempReadJob ;
+	psReq->pvArg	= (void *) ThisDev ;
+	psReq->Cmd		= ds248xREQ_EXEC ;
+	psReq->Flags	= ds248xREQF_POST ;					// EXEC job, PRIO could not overtake anything
+	if (ds248xAsyncSubmit(ds248xDEV(DevNum), psReq) == erSUCCESS) return ;
+	IF_SL_INFO(debugTRACK, "Dev=%d sample job not queued", DevNum) ;
+#endif
+	OWP_TempReadBus(ThisDev) ;
+}
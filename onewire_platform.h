@@ -14,9 +14,40 @@ extern "C" {
 
 // ############################################# Macros ############################################
 
+#define	owPLATFORM_PARALLEL			1					// scan/sample DS248x devices concurrently
+#define	owPLATFORM_CONVERT_ALL		1					// convert all powered buses at once, 1 wait per cycle
+#define	owPLATFORM_CONVERT_POLL		1					// powered buses read as soon as conversion completes
+
+#if		(owPLATFORM_PARALLEL > 0) && (ds248xBUILD_ASYNC == 0)
+	#error "owPLATFORM_PARALLEL requires ds248xBUILD_ASYNC"
+#endif
+#if		(owPLATFORM_CONVERT_POLL > 0) && (owPLATFORM_CONVERT_ALL == 0)
+	#error "owPLATFORM_CONVERT_POLL requires owPLATFORM_CONVERT_ALL"
+#endif
+
+
+#define	owbiOD_ALL					0xFFFFFFFFFFFFFFFFULL	// ODrom after Overdrive Skip ROM
 
 // ######################################## Enumerations ###########################################
 
+enum {													// bus health events, counted per logical bus
+	owbiEV_RESET,										// 1-Wire resets issued
+	owbiEV_NOPPD,										// no presence pulse after reset
+	owbiEV_SD,											// short detected during reset
+	owbiEV_CRC,											// ROM or scratchpad CRC failure
+	owbiEV_ABORT,										// search started but failed
+	owbiEV_DEVRST,										// bridge reset by error recovery
+	owbiEV_BUSY,										// 1-Wire busy timeout
+	owbiEV_RESUME,										// Resume ROM sent instead of Match ROM + 8 bytes
+	owbiEV_NUM,
+} ;
+
+enum {													// latency histograms per high level operation
+	owpH_SEARCH,										// OWSearch(), one device found or search end
+	owpH_READSP,										// ds18x20ReadSP()
+	owpH_TEMP,											// OWP_TempAllInOne(), full temperature cycle
+	owpH_NUM,
+} ;
 
 // ######################################### Structures ############################################
 
@@ -34,13 +65,17 @@ typedef struct __attribute__((packed)) owbi_t {
 		} ;
 		uint16_t	ds18any ;
 	} ;
+	uint16_t			Health[owbiEV_NUM] ;			// always on, see OWP_BusEvent()
+	ow_rom_t			RCrom ;							// device with RC flag set by last Match ROM, 0 = none
+	ow_rom_t			ODrom ;							// device at overdrive, 0 = none, owbiOD_ALL = all capable
 } owbi_t ;
-DUMB_STATIC_ASSERT(sizeof(owbi_t) == 14) ;
+DUMB_STATIC_ASSERT(sizeof(owbi_t) == 46) ;
 
 // #################################### Public Data structures #####################################
 
 extern	owbi_t * psaOWBI ;
 extern	ow_flags_t	OWflags ;
+extern	owhist_t	OWP_Hist[owpH_NUM] ;
 
 // ###################################### Public functions #########################################
 
@@ -50,6 +85,13 @@ int	OWP_BusP2L(owdi_t *) ;
 int	OWP_BusSelect(owdi_t *) ;
 int	OWP_BusSelectAndAddress(owdi_t *, uint8_t) ;
 void OWP_BusRelease(owdi_t *) ;
+void OWP_BusEvent(uint8_t LogBus, int Event) ;
+uint64_t OWP_BusResumeGet(uint8_t LogBus) ;
+void OWP_BusResumeSet(uint8_t LogBus, uint64_t Value) ;
+uint64_t OWP_BusODGet(uint8_t LogBus) ;
+void OWP_BusODSet(uint8_t LogBus, uint64_t Value) ;
+void OWP_ReportHealth(void) ;
+void OWP_ReportHist(bool Reset) ;
 
 // Common callback handlers
 int	OWP_PrintROM_CB(flagmask_t FlagMask, ow_rom_t * psROM) ;
@@ -60,6 +102,7 @@ int	OWP_Count_CB(flagmask_t FlagMask, owdi_t *) ;
 
 int	OWP_Scan(uint8_t, int (*)(flagmask_t, owdi_t *), owdi_t *) ;
 int	OWP_Scan2(uint8_t, int (*)(flagmask_t, void *, owdi_t *), void *, owdi_t *) ;
+int	OWP_ScanList(uint8_t, int (*)(flagmask_t, owdi_t *), owdi_t *) ;
 int	OWP_ScanAlarmsFamily(uint8_t Family) ;
 
 struct epw_t ;
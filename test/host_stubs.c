@@ -0,0 +1,100 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * host_stubs.c - FreeRTOS, HAL & support component stand-ins for the Linux host build
+ */
+
+#include	"hal_variables.h"
+#include	"ds248x_emul.h"
+
+#include	<stdio.h>
+#include	<stdarg.h>
+
+// ########################################### FreeRTOS ############################################
+
+void	vTaskDelay(TickType_t Ticks) { ds248xEmulIdle((uint64_t) Ticks * portTICK_PERIOD_MS * 1000ULL) ; }
+TaskHandle_t xTaskGetCurrentTaskHandle(void) { return NULL ; }
+BaseType_t xTaskCreate(void (* pvF)(void *), const char * pcN, uint32_t S, void * pvP, UBaseType_t P, TaskHandle_t * pH) { return pdFALSE ; }
+int		xTaskNotify(TaskHandle_t hT, uint32_t V, int A) { return pdPASS ; }
+void	xTaskNotifyGive(TaskHandle_t hT) { }
+uint32_t ulTaskNotifyTake(BaseType_t C, TickType_t T) { return 1 ; }
+
+TimerHandle_t xTimerCreate(const char * pcN, TickType_t T, int R, void * pvID, void (* pvF)(TimerHandle_t)) { return (TimerHandle_t) 1 ; }
+void	vTimerSetTimerID(TimerHandle_t hT, void * pvID) { }
+void *	pvTimerGetTimerID(TimerHandle_t hT) { return NULL ; }
+int		xTimerStart(TimerHandle_t hT, TickType_t T) { return pdPASS ; }
+int		xTimerChangePeriod(TimerHandle_t hT, TickType_t P, TickType_t T) { return pdPASS ; }
+
+// no queues, ds248xAsyncSubmit() fails and callers run the request inline
+QueueHandle_t xQueueCreate(UBaseType_t L, UBaseType_t S) { return NULL ; }
+BaseType_t xQueueSend(QueueHandle_t hQ, const void * pvI, TickType_t T) { return pdFALSE ; }
+BaseType_t xQueueSendToFront(QueueHandle_t hQ, const void * pvI, TickType_t T) { return pdFALSE ; }
+BaseType_t xQueueReceive(QueueHandle_t hQ, void * pvI, TickType_t T) { return pdFALSE ; }
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t hQ) { return 0 ; }
+void	vQueueDelete(QueueHandle_t hQ) { }
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t M, UBaseType_t I) { return NULL ; }
+SemaphoreHandle_t xSemaphoreCreateBinary(void) { return NULL ; }
+BaseType_t xSemaphoreTake(SemaphoreHandle_t hS, TickType_t T) { return pdTRUE ; }
+BaseType_t xSemaphoreGive(SemaphoreHandle_t hS) { return pdTRUE ; }
+void	vSemaphoreDelete(SemaphoreHandle_t hS) { }
+// single threaded, a take while held would block forever and a give while free is a bug
+int		HostMuxErr = 0 ;
+int		xRtosSemaphoreTake(SemaphoreHandle_t * phS, TickType_t T) {
+	if (*phS) ++HostMuxErr ;
+	*phS = (SemaphoreHandle_t) 1 ;
+	return pdTRUE ;
+}
+int		xRtosSemaphoreGive(SemaphoreHandle_t * phS) {
+	if (*phS == NULL) ++HostMuxErr ;
+	*phS = NULL ;
+	return pdTRUE ;
+}
+
+EventGroupHandle_t xEventGroupCreate(void) { return NULL ; }
+EventBits_t xEventGroupSetBits(EventGroupHandle_t hE, EventBits_t B) { return 0 ; }
+EventBits_t xEventGroupClearBits(EventGroupHandle_t hE, EventBits_t B) { return 0 ; }
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t hE, EventBits_t B, BaseType_t C, BaseType_t A, TickType_t T) { return B ; }
+
+// ######################################## Support components #####################################
+
+int		printfx(const char * pcFormat, ...) {
+	va_list vArgs ;
+	va_start(vArgs, pcFormat) ;
+	int iRV = vprintf(pcFormat, vArgs) ;
+	va_end(vArgs) ;
+	return iRV ;
+}
+
+int		snprintfx(char * pcBuf, size_t Size, const char * pcFormat, ...) {
+	va_list vArgs ;
+	va_start(vArgs, pcFormat) ;
+	int iRV = vsnprintf(pcBuf, Size, pcFormat, vArgs) ;
+	va_end(vArgs) ;
+	return iRV ;
+}
+
+char *	pcBitMapDecodeChanges(uint32_t Val1, uint32_t Val2, uint32_t Mask, const char * const * pcMes) { return strdup("") ; }
+void	vShowActivity(int i) { }
+int64_t	esp_timer_get_time(void) { return (int64_t) ds248xEmulMicros() ; }
+
+epw_t			table_work[URI_DS1990X + 1] ;
+uint64_t		RunTime ;
+tsz_t			sTSZ ;
+TaskHandle_t	EventsHandle ;
+seconds_t xTimeStampAsSeconds(uint64_t Time) { return Time / 1000000ULL ; }
+
+int		xStringSkipDelim(char * pcSrc, int Sep, int Len) { return 0 ; }
+int32_t	xCLImatch(cli_t * psCLI) { return erFAILURE ; }
+char *	pcStringParseValueRange(char * pcSrc, px_t pX, int cvF, int cvS, int Sep, x32_t Lo, x32_t Hi) { return pcFAILURE ; }
+
+// ############################################## HAL ##############################################
+
+struct ds248x_t *	psaDS248X = NULL ;
+uint8_t				ds248xCount = 0 ;
+
+int		halI2C_Queue(i2c_di_t * psI2C, int eType, uint8_t * pTxBuf, size_t TxSize, uint8_t * pRxBuf,
+					size_t RxSize, i2cq_p1_t p1, i2cq_p2_t p2) { return erFAILURE ; }
+void	halI2C_DeviceReport(void * pvPara) { }
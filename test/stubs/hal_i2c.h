@@ -0,0 +1,3 @@
+/* Host build stand-in, see host_stubs.h */
+#pragma		once
+#include	"host_stubs.h"
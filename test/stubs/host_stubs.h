@@ -0,0 +1,217 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * host_stubs.h - minimal FreeRTOS, HAL & support component declarations for the Linux host build
+ *
+ * Only what the 1-Wire component uses is declared. Every HAL/support header the component
+ * includes is a one line wrapper around this file. Queues & tasks are not available, requests
+ * to the ds248x async worker fail and are run inline by the callers.
+ */
+
+#pragma		once
+
+#include	<stdint.h>
+#include	<stdbool.h>
+#include	<stddef.h>
+#include	<stdlib.h>
+#include	<string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ########################################### FreeRTOS ############################################
+
+typedef void *		SemaphoreHandle_t ;
+typedef void *		TimerHandle_t ;
+typedef void *		TaskHandle_t ;
+typedef void *		QueueHandle_t ;
+typedef void *		EventGroupHandle_t ;
+typedef uint32_t	TickType_t ;
+typedef int			BaseType_t ;
+typedef uint32_t	UBaseType_t ;
+typedef uint32_t	EventBits_t ;
+typedef int			portMUX_TYPE ;
+
+#define	portTICK_PERIOD_MS			1
+#define	pdMS_TO_TICKS(x)			((TickType_t) (x))
+#define	portMAX_DELAY				0xFFFFFFFF
+#define	pdTRUE						1
+#define	pdFALSE						0
+#define	pdPASS						1
+#define	tskIDLE_PRIORITY			0
+#define	portYIELD()
+#define	portMUX_INITIALIZER_UNLOCKED	0
+#define	portENTER_CRITICAL(x)		(void) (x)
+#define	portEXIT_CRITICAL(x)		(void) (x)
+
+enum { eSetBits, eNoAction, eIncrement } ;
+
+void		vTaskDelay(TickType_t) ;					// advances the emulator virtual clock
+TaskHandle_t xTaskGetCurrentTaskHandle(void) ;
+BaseType_t	xTaskCreate(void (*)(void *), const char *, uint32_t, void *, UBaseType_t, TaskHandle_t *) ;
+int			xTaskNotify(TaskHandle_t, uint32_t, int) ;
+void		xTaskNotifyGive(TaskHandle_t) ;
+uint32_t	ulTaskNotifyTake(BaseType_t, TickType_t) ;
+
+TimerHandle_t xTimerCreate(const char *, TickType_t, int, void *, void (*)(TimerHandle_t)) ;
+void		vTimerSetTimerID(TimerHandle_t, void *) ;
+void *		pvTimerGetTimerID(TimerHandle_t) ;
+int			xTimerStart(TimerHandle_t, TickType_t) ;
+int			xTimerChangePeriod(TimerHandle_t, TickType_t, TickType_t) ;
+
+QueueHandle_t xQueueCreate(UBaseType_t, UBaseType_t) ;
+BaseType_t	xQueueSend(QueueHandle_t, const void *, TickType_t) ;
+BaseType_t	xQueueSendToFront(QueueHandle_t, const void *, TickType_t) ;
+BaseType_t	xQueueReceive(QueueHandle_t, void *, TickType_t) ;
+UBaseType_t	uxQueueMessagesWaiting(QueueHandle_t) ;
+void		vQueueDelete(QueueHandle_t) ;
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t, UBaseType_t) ;
+SemaphoreHandle_t xSemaphoreCreateBinary(void) ;
+BaseType_t	xSemaphoreTake(SemaphoreHandle_t, TickType_t) ;
+BaseType_t	xSemaphoreGive(SemaphoreHandle_t) ;
+void		vSemaphoreDelete(SemaphoreHandle_t) ;
+int			xRtosSemaphoreTake(SemaphoreHandle_t *, TickType_t) ;
+int			xRtosSemaphoreGive(SemaphoreHandle_t *) ;
+extern int	HostMuxErr ;								// xRtosSemaphoreTake() while held or Give() while free
+
+EventGroupHandle_t xEventGroupCreate(void) ;
+EventBits_t	xEventGroupSetBits(EventGroupHandle_t, EventBits_t) ;
+EventBits_t	xEventGroupClearBits(EventGroupHandle_t, EventBits_t) ;
+EventBits_t	xEventGroupWaitBits(EventGroupHandle_t, EventBits_t, BaseType_t, BaseType_t, TickType_t) ;
+
+// ######################################## Support macros #########################################
+
+#define	DUMB_STATIC_ASSERT(x)		_Static_assert(sizeof(void *) != 4 || (x), #x)	// target (ILP32) layouts
+#define	SO_MEM(t, m)				sizeof(((t *) 0)->m)
+#define	NO_MEM(a)					(sizeof(a) / sizeof(a[0]))
+#define	INRANGE(lo, x, hi, t)		(((t) (lo) <= (t) (x)) && ((t) (x) <= (t) (hi)))
+
+#define	debugFLAG_GLOBAL			0xFFFF
+#define	myASSERT(x)					(void) (x)
+#define	IF_myASSERT(f, x)			do { if (f) (void) (x) ; } while (0)
+#define	IF_TRACK(f, ...)			do { if (f) printfx(__VA_ARGS__) ; } while (0)
+#define	IF_PRINT(f, ...)			do { if (f) printfx(__VA_ARGS__) ; } while (0)
+#define	IF_EXEC_2(f, fn, a, b)		do { if (f) fn(a, b) ; } while (0)
+#define	IF_SYSTIMER_START(f, x)		(void) (x)
+#define	IF_SYSTIMER_STOP(f, x)		(void) (x)
+#define	IF_SYSTIMER_INIT(f, x, ...)	(void) (x)
+#define	SL_ERR(...)					printfx(__VA_ARGS__)
+#define	SL_INFO(...)				printfx(__VA_ARGS__)
+#define	SL_WARN(...)				printfx(__VA_ARGS__)
+#define	IF_SL_ERR(f, ...)			do { if (f) printfx(__VA_ARGS__) ; } while (0)
+#define	IF_SL_INFO(f, ...)			do { if (f) printfx(__VA_ARGS__) ; } while (0)
+#define	LT_GOTO(a, b, l)			do { if ((a) < (b)) goto l ; } while (0)
+#define	SET_ERRINFO(x)				(void) (x)
+
+enum { erSUCCESS = 0, erFAILURE = -1, erSCRIPT_INV_VALUE = -2, erSCRIPT_INV_OPERATION = -3,
+		erSCRIPT_INV_INDEX = -4, erSCRIPT_INV_MODE = -5, erINVALID_PARA = -6, erTIMEOUT = -7, erNO_MEM = -8 } ;
+
+enum { stDS248xA, stDS248xB, stDS248xC, stDS248xD, stDS248xE, stDS248xF, stOW1, stOW2,
+		stDS1820A, stDS1820B, stDS1990, stMICROS, stMILLIS } ;
+
+int			printfx(const char *, ...) ;
+int			snprintfx(char *, size_t, const char *, ...) ;
+char *		pcBitMapDecodeChanges(uint32_t, uint32_t, uint32_t, const char * const *) ;
+void		vShowActivity(int) ;
+int64_t		esp_timer_get_time(void) ;
+
+// ####################################### Values & endpoints ######################################
+
+typedef uint32_t seconds_t ;
+
+typedef union {
+	struct { uint8_t Family ; uint8_t TagNum[6] ; uint8_t CRC ; } ;
+	uint8_t		HexChars[8] ;
+	uint64_t	Value ;
+} ow_rom_t ;
+
+typedef union {
+	struct { uint32_t uCount : 24, bRT : 1, bNL : 1, bCount : 1, spare : 5 ; } ;
+	uint32_t	u32Val ;
+} flagmask_t ;
+
+#define	mfbRT						(1 << 24)
+#define	mfbNL						(1 << 25)
+#define	mfbCOUNT					(1 << 26)
+#define	makeMASKFLAG(a,b,c,d,e,f,g,h,i,j,k,l,m)	((flagmask_t) (uint32_t) (m))
+
+typedef union { void * pv ; uint32_t * pu32 ; } px_t ;
+typedef union { float f32 ; uint32_t u32 ; int i32 ; } x32_t ;
+
+typedef struct epw_t {
+	struct {
+		struct { struct { uint8_t pntr, vf, vs, vt, vc ; } cv ; } def ;
+		struct { struct { float f32 ; } x32 ; px_t px ; } val ;
+	} var ;
+	uint32_t	Tsns, Rsns ;
+	uint8_t		idx, uri, fSECsns ;
+} epw_t ;
+
+typedef struct { void * work, * reset, * sense, * get ; } vt_enum_t ;
+
+enum { vfFXX, vfUXX, vs32B, vtVALUE, vtENUM, URI_DS18X20, URI_DS1990X } ;
+
+struct rule_t { uint8_t ActIdx ; uint8_t actPar0[4] ; union { uint32_t u32[4][5] ; } para ; } ;
+typedef struct { uint64_t usecs ; } tsz_t ;
+
+extern epw_t		table_work[] ;
+extern uint64_t		RunTime ;
+extern tsz_t		sTSZ ;
+extern TaskHandle_t	EventsHandle ;
+seconds_t	xTimeStampAsSeconds(uint64_t) ;
+
+#define	evtFIRST_OW					0
+
+// ############################################## CLI ##############################################
+
+typedef struct cli_t cli_t ;
+typedef struct { const char * cmd ; int32_t (* hdlr)(cli_t *) ; } cmnd_t ;
+struct cli_t {
+	cmnd_t *	pasList ;
+	uint8_t		u8LSize ;
+	char *		pcParse, * pcStore ;
+	union { struct { union { struct { union { uint8_t u8 ; } x8[8] ; } ; union { uint32_t u32 ; } x32[2] ; } ; } x64 ; } z64Var ;
+} ;
+
+#define	sepSPACE_COMMA				0
+#define	sepSPACE_LF					0
+#define	pcFAILURE					((char *) -1)
+
+int			xStringSkipDelim(char *, int, int) ;
+int32_t		xCLImatch(cli_t *) ;
+char *		pcStringParseValueRange(char *, px_t, int, int, int, x32_t, x32_t) ;
+
+// ############################################## HAL ##############################################
+
+#define	halHAS_DS248X				1
+#define	halHAS_DS18X20				1
+#define	halHAS_DS1990X				1
+#define	halCONFIG_inSRAM(p)			((p) != NULL)
+#define	halCONFIG_inFLASH(p)		((p) != NULL)
+
+typedef void *	i2cq_p1_t ;
+typedef void *	i2cq_p2_t ;
+
+enum { i2cR_B, i2cWDR_B, i2cWR_B, i2cW_B } ;
+enum { i2cDEV_UNDEF, i2cDEV_DS2482_10X, i2cDEV_DS2482_800, i2cDEV_DS2484 } ;
+enum { i2cSPEED_100, i2cSPEED_400, i2cSPEED_1000 = 4 } ;		// not contiguous on purpose
+
+typedef struct i2c_di_t {
+	uint8_t		DevIdx, Type, Speed, Test, Addr ;
+	TickType_t	Delay ;
+} i2c_di_t ;
+
+int			halI2C_Queue(i2c_di_t *, int, uint8_t *, size_t, uint8_t *, size_t, i2cq_p1_t, i2cq_p2_t) ;
+void		halI2C_DeviceReport(void *) ;
+
+struct ds248x_t ;
+extern struct ds248x_t *	psaDS248X ;
+extern uint8_t				ds248xCount ;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * test_common.h - host test helpers, checks & the reference emulated installation
+ */
+
+#pragma		once
+
+#include	"onewire_platform.h"
+#include	"ds248x_emul.h"
+
+#include	<stdio.h>
+
+// ############################################# Macros ############################################
+
+#define	TEST_CHECK(x)	do { if (!(x)) { printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #x) ; ++TestFail ; } } while (0)
+#define	TEST_EQUAL(a, b) do { long long A = (a), B = (b) ; if (A != B) { printf("FAIL %s:%d %s=%lld expected %lld\n", __FILE__, __LINE__, #a, A, B) ; ++TestFail ; } } while (0)
+#define	TEST_RESULT()	(HostMuxErr ? printf("FAIL bus mutex misuse %d\n", HostMuxErr), ++TestFail : 0, \
+						printf("%s\n", TestFail ? "FAILED" : "PASSED"), TestFail ? 1 : 0)
+
+#define	testTRAW_28(c)				(0x0191 + (c))		// 25.0625C + 1/16C per channel
+#define	testTRAW_10					0x0150				// 21C
+#define	testTRAW_42(i)				(0x0300 + ((i) << 4))	// 48C + 1C per device
+
+// ###################################### Local variables ##########################################
+
+static int TestFail = 0 ;
+
+// ###################################### Helper functions #########################################
+
+/**
+ * @brief	Reference installation: DS2482-800 with a DS18B20 & DS18S20 per channel, DS2484 with
+ *			2x DS18B20 and a DS2482-10x with a DS1990, sensors powered as per Pwr
+ * @return	number of bridges configured
+ */
+static inline int TestRig(bool Pwr) {
+	ds248xEmulAddBridge(i2cDEV_DS2482_800) ;
+	ds248xEmulAddBridge(i2cDEV_DS2484) ;
+	ds248xEmulAddBridge(i2cDEV_DS2482_10X) ;
+	for (int c = 0; c < 8; ++c) {
+		ds248xEmulAddDevice(0, c, OWFAMILY_28, Pwr, testTRAW_28(c)) ;
+		ds248xEmulAddDevice(0, c, OWFAMILY_10, Pwr, testTRAW_10) ;
+	}
+	ds248xEmulAddDevice(1, 0, OWFAMILY_28, Pwr, 0x0200) ;
+	ds248xEmulAddDevice(1, 0, OWFAMILY_28, Pwr, 0x0210) ;
+	ds248xEmulAddDevice(2, 0, OWFAMILY_01, 1, 0) ;
+	return ds248xEmulStart() ;
+}
+
+/**
+ * @brief	Reset, address (MATCHROM) & read the scratchpad of one device, bus selected here
+ * @return	speed the device was addressed at
+ */
+static inline int TestReadSP(owdi_t * psOW, int16_t Traw) {
+	ds248x_t * psDS248X = ds248xDEV(psOW->DevNum) ;
+	uint8_t aSP[9] ;
+	TEST_EQUAL(OWP_BusSelect(psOW), 1) ;
+	TEST_EQUAL(OWReset(psOW), 1) ;
+	OWAddress(psOW, OW_CMD_MATCHROM) ;
+	int OWS = psDS248X->OWS ;
+	OWWriteByte(psOW, DS18X20_READ_SP) ;
+	for (int i = 0; i < sizeof(aSP); aSP[i++] = OWReadByte(psOW)) ;
+	OWP_BusRelease(psOW) ;
+	TEST_EQUAL(OWCheckCRC(aSP, sizeof(aSP)), 1) ;
+	TEST_EQUAL((aSP[1] << 8) | aSP[0], Traw) ;
+	return OWS ;
+}
+
+/**
+ * @brief	Check every DS18B20 reports the temperature it was created with
+ */
+static inline void TestCheckTemps(void) {
+	for (int i = 0; i < Fam10_28Count; ++i) {
+		ds18x20_t * psDS18X20 = &psaDS18X20[i] ;
+		if (psDS18X20->sOW.ROM.Family != OWFAMILY_28) continue ;
+		int16_t Traw = (psDS18X20->sOW.DevNum == 0) ? testTRAW_28(psDS18X20->sOW.PhyBus)
+					 : (psDS18X20->sOW.ROM.TagNum[0] == 0) ? 0x0200 : 0x0210 ;
+		float Texp = (float) Traw / 16.0 ;
+		if (psDS18X20->sEWx.var.val.x32.f32 != Texp) {
+			printf("FAIL sensor %d D=%d P=%d T=%.4f expected %.4f\n", i, psDS18X20->sOW.DevNum,
+					psDS18X20->sOW.PhyBus, psDS18X20->sEWx.var.val.x32.f32, Texp) ;
+			++TestFail ;
+		}
+	}
+}
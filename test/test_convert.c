@@ -0,0 +1,32 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * test_convert.c - temperature cycle timing, externally powered & parasitic sensors
+ */
+
+#include	"test_common.h"
+
+int main(int argc, char * argv[]) {
+	bool Pwr = (argc < 2 || argv[1][0] != 'p') ;		// "para" for parasitic sensors
+	ds248xEmulAddBridge(i2cDEV_DS2482_800) ;
+	ds248xEmulAddBridge(i2cDEV_DS2484) ;
+	for (int c = 0; c < 8; ++c) ds248xEmulAddDevice(0, c, OWFAMILY_28, Pwr, testTRAW_28(c)) ;
+	ds248xEmulAddDevice(1, 0, OWFAMILY_28, Pwr, 0x0200) ;
+	ds248xEmulAddDevice(1, 0, OWFAMILY_28, Pwr, 0x0210) ;
+	TEST_EQUAL(ds248xEmulStart(), 2) ;
+	TEST_EQUAL(OWP_Config(), 10) ;
+	for (int i = 0; i < Fam10_28Count; ++i) TEST_EQUAL(psaDS18X20[i].Pwr, Pwr) ;
+
+	ds248xEmulResetCounters() ;
+	uint64_t t0 = ds248xEmulMicros() ;
+	OWP_TempAllInOne(NULL) ;
+	uint32_t uS = ds248xEmulMicros() - t0 ;
+	printf("OWP_TempAllInOne %s: %uuS  Trans=%u\n", Pwr ? "powered" : "parasitic", uS, ds248xEmulTrans()) ;
+	ds248xEmulReport() ;
+	TestCheckTemps() ;
+	// powered: all 9 buses convert together, 750mS at 12 bit, parasitic: one bus at a time
+	TEST_CHECK(Pwr ? (uS < 900000) : (uS > 9 * 750000)) ;
+	return TEST_RESULT() ;
+}
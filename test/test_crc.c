@@ -0,0 +1,48 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * test_crc.c - CRC8 & CRC16 variants against the bit-wise reference & check values
+ */
+
+#include	"test_common.h"
+#include	"onewire_crc.h"
+
+int main(void) {
+	const uint8_t Check[] = "123456789" ;
+	TEST_EQUAL(OWCrc8Bit(0, Check, 9), 0xA1) ;			// CRC-8/MAXIM
+	TEST_EQUAL(OWCrc16Bit(0, Check, 9), 0xBB3D) ;		// CRC-16/ARC
+
+	uint8_t aBuf[67] ;
+	uint32_t Seed = 0x12345678 ;
+	for (int Loop = 0; Loop < 200; ++Loop) {
+		for (int i = 0; i < sizeof(aBuf); ++i) {
+			Seed = (Seed * 1103515245U) + 12345U ;
+			aBuf[i] = Seed >> 16 ;
+		}
+		size_t Len = Loop % sizeof(aBuf) ;				// every length, every alignment of the tail
+		uint8_t C8 = OWCrc8Bit(Loop, aBuf, Len) ;
+		TEST_EQUAL(OWCrc8Nibble(Loop, aBuf, Len), C8) ;
+		TEST_EQUAL(OWCrc8Table(Loop, aBuf, Len), C8) ;
+		TEST_EQUAL(OWCrc8(Loop, aBuf, Len), C8) ;
+		uint8_t B8 = Loop ;
+		for (int i = 0; i < Len; ++i) B8 = OWCrc8Byte(B8, aBuf[i]) ;
+		TEST_EQUAL(B8, C8) ;
+		uint16_t C16 = OWCrc16Bit(Loop, aBuf, Len) ;
+		TEST_EQUAL(OWCrc16Table(Loop, aBuf, Len), C16) ;
+		TEST_EQUAL(OWCrc16Slice4(Loop, aBuf, Len), C16) ;
+		TEST_EQUAL(OWCrc16(Loop, aBuf, Len), C16) ;
+	}
+
+	// memory page as read from a device: data then inverted CRC16 LSB first
+	uint8_t aPage[32 + 2] ;
+	memcpy(aPage, aBuf, 32) ;
+	uint16_t Crc = ~OWCrc16(0, aPage, 32) ;
+	aPage[32] = Crc & 0xFF ;
+	aPage[33] = Crc >> 8 ;
+	TEST_CHECK(OWCrc16Check(0, aPage, 32)) ;
+	aPage[7] ^= 0x10 ;
+	TEST_CHECK(OWCrc16Check(0, aPage, 32) == 0) ;
+	return TEST_RESULT() ;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * test_fault.c - driver behaviour with emulator fault injection
+ */
+
+#include	"test_common.h"
+
+/**
+ * @brief	1-Wire slower than the nominal delays, DATA must not be read while 1WB set
+ */
+static void TestSlow(void) {
+	ds248x_t * psDS248X = ds248xDEV(0) ;
+	uint16_t Busy = psDS248X->Err[ds248xERR_OWB] ;
+	ds248xEmulSlow(0, 40) ;
+	OWP_TempAllInOne(NULL) ;
+	ds248xEmulSlow(0, 0) ;
+	TestCheckTemps() ;
+	printf("Slow: OWB=%u\n", psDS248X->Err[ds248xERR_OWB] - Busy) ;
+	TEST_EQUAL(psDS248X->Err[ds248xERR_OWB], Busy) ;	// longer polls, never a busy timeout
+}
+
+/**
+ * @brief	CHSL NACK'ed, the select fails with the device left unlocked, the next cycle recovers
+ */
+static void TestChsl(void) {
+	ds248x_t * psDS248X = ds248xDEV(0) ;
+	ds248xEmulFail(0, ds2482CMD_CHSL, 1, 0) ;
+	OWP_TempAllInOne(NULL) ;
+	TEST_EQUAL(HostMuxErr, 0) ;
+	OWP_TempAllInOne(NULL) ;
+	TestCheckTemps() ;
+	printf("Chsl: CurChan=%u\n", psDS248X->CurChan) ;
+}
+
+/**
+ * @brief	DS2484 overdrive port values programmed, standard speed timing must be unaffected
+ */
+static void TestPadj(void) {
+	ds248x_t * psDS248X = ds248xDEV(1) ;
+	TEST_EQUAL(ds248xPortAdjust(psDS248X, ds2484PAR_TRSTL, 1, 0), 1) ;
+	TEST_EQUAL(ds248xPortAdjust(psDS248X, ds2484PAR_TW0L, 1, 0), 1) ;
+	owdi_t sOW ;
+	OWP_BusL2P(&sOW, 8) ;								// DS2484 bus
+	TEST_EQUAL(OWP_BusSelect(&sOW), 1) ;
+	TEST_EQUAL(OWReset(&sOW), 1) ;						// standard tRSTL still long enough
+	OWP_BusRelease(&sOW) ;
+	TEST_EQUAL(ds248xPortAdjust(psDS248X, ds2484PAR_TRSTL, 0, ds2484PADJ_DEFAULT), 1) ;
+	TEST_EQUAL(psDS248X->Err[ds248xERR_RDBK], 0) ;
+}
+
+/**
+ * @brief	I2C errors not cured by retries step the DS2484 down from 1MHz to 400KHz
+ */
+static void TestSpeedDown(void) {
+	ds248x_t * psDS248X = ds248xDEV(1) ;
+	TEST_EQUAL(psDS248X->psI2C->Speed, i2cSPEED_1000) ;
+	ds248xEmulFail(1, ds248xCMD_1WRS, ds248xREC_RETRIES + 1, 0) ;
+	owdi_t sOW ;
+	OWP_BusL2P(&sOW, 8) ;
+	TEST_EQUAL(OWP_BusSelect(&sOW), 1) ;
+	TEST_EQUAL(OWReset(&sOW), 1) ;
+	OWP_BusRelease(&sOW) ;
+	TEST_EQUAL(psDS248X->psI2C->Speed, i2cSPEED_400) ;
+	TEST_EQUAL(psDS248X->SpeedDown, 1) ;
+	OWP_TempAllInOne(NULL) ;
+	TestCheckTemps() ;
+}
+
+/**
+ * @brief	1-Wire command executed but its I2C transaction NACK'ed, repeating the command alone
+ *			would consume an extra byte (1WRB) or write one twice (1WWB)
+ */
+static void TestDoneNack(void) {
+	ds248x_t * psDS248X = ds248xDEV(0) ;
+	ds18x20_t * psDS18X20 = &psaDS18X20[1] ;			// DS18B20 on -800 channel 0
+	TEST_EQUAL(psDS18X20->sOW.ROM.Family, OWFAMILY_28) ;
+	TEST_EQUAL(OWP_BusSelect(&psDS18X20->sOW), 1) ;
+	uint16_t Rec = psDS248X->Rec[ds248xREC_RETRY] ;
+	ds248xEmulFail(0, ds248xCMD_1WRB, 1, 1) ;			// temperature only, no CRC
+	TEST_EQUAL(ds18x20ReadSP(psDS18X20, 2), 1) ;
+	TEST_EQUAL(psDS18X20->Tmsb << 8 | psDS18X20->Tlsb, testTRAW_28(0)) ;
+	ds248xEmulFail(0, ds248xCMD_1WWB, 1, 1) ;			// MATCHROM command byte
+	psDS18X20->Thi = 60 ;
+	psDS18X20->Tlo = 10 ;
+	TEST_EQUAL(ds18x20WriteSP(psDS18X20), 1) ;
+	psDS18X20->Thi = psDS18X20->Tlo = 0 ;
+	TEST_EQUAL(ds18x20ReadSP(psDS18X20, SO_MEM(ds18x20_t, RegX)), 1) ;
+	TEST_EQUAL(psDS18X20->Thi, 60) ;
+	TEST_EQUAL(psDS18X20->Tlo, 10) ;
+	TEST_CHECK(psDS248X->Rec[ds248xREC_RETRY] > Rec) ;
+	TEST_EQUAL(psDS248X->OWErr, 0) ;
+	OWP_BusRelease(&psDS18X20->sOW) ;
+}
+
+/**
+ * @brief	Strong pullup after a convert, a speed change (WCFG) must not re-arm it for the
+ *			address bytes that follow
+ */
+static void TestSpuSpeed(void) {
+	ds248x_t * psDS248X = ds248xDEV(1) ;
+	owdi_t sOW ;
+	OWP_BusL2P(&sOW, 8) ;
+	TEST_EQUAL(OWP_BusSelect(&sOW), 1) ;
+	uint32_t Spu = ds248xEmulSpu(1) ;
+	TEST_EQUAL(OWResetCommand(&sOW, DS18X20_CONVERT, 1, 1), 1) ;
+	TEST_EQUAL(ds248xEmulSpu(1) - Spu, 1) ;
+	ds248xOWSpeed(psDS248X, owSPEED_ODRIVE) ;
+	ds248xOWSpeed(psDS248X, owSPEED_STANDARD) ;
+	TEST_EQUAL(OWReset(&sOW), 1) ;
+	OWAddress(&sOW, OW_CMD_SKIPROM) ;
+	TEST_EQUAL(ds248xEmulSpu(1) - Spu, 1) ;
+	TEST_EQUAL(psDS248X->SPU, 0) ;
+	OWP_BusRelease(&sOW) ;
+}
+
+int main(void) {
+	TEST_EQUAL(TestRig(1), 3) ;
+	TEST_EQUAL(OWP_Config(), 19) ;
+	OWP_TempAllInOne(NULL) ;
+	TestCheckTemps() ;
+	TestSlow() ;
+	TestChsl() ;
+	TestPadj() ;
+	TestSpeedDown() ;
+	TestDoneNack() ;
+	TestSpuSpeed() ;
+	return TEST_RESULT() ;
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * test_hist.c - latency histogram bucketing, percentiles & snapshot/reset
+ */
+
+#include	"test_common.h"
+#include	"onewire_hist.h"
+
+static owhist_t sH, sS ;
+
+// percentile reported as the bucket upper bound, never below the sample, at most ~1/owHIST_SUB above
+#define	testPCT(p, x)	do { uint32_t P = OWHistPercentile(&sH, p) ; \
+	if (P < (x) || P > (x) + ((x) / owHIST_SUB) + 1) { printf("FAIL P%d=%u for %u\n", p, P, x) ; ++TestFail ; } } while (0)
+
+int main(void) {
+	TEST_EQUAL(OWHistPercentile(&sH, 50), 0) ;
+	for (uint32_t uS = 1; uS <= 1000; ++uS) OWHistAdd(&sH, uS * 100) ;	// 100uS -> 100mS
+	TEST_EQUAL(OWHistTotal(&sH), 1000) ;
+	TEST_EQUAL(sH.Max, 100000) ;
+	testPCT(50, 50000) ;
+	testPCT(90, 90000) ;
+	testPCT(99, 99000) ;
+	TEST_EQUAL(OWHistPercentile(&sH, 100), 100000) ;	// clamped to Max
+	testPCT(1, 1000) ;
+
+	OWHistAdd(&sH, 0) ;
+	OWHistAdd(&sH, 10000000) ;							// past the last bucket
+	TEST_EQUAL(OWHistTotal(&sH), 1002) ;
+	TEST_EQUAL(OWHistPercentile(&sH, 100), 10000000) ;
+
+	OWHistSnapshot(&sS, &sH, 1) ;
+	TEST_EQUAL(OWHistTotal(&sS), 1002) ;
+	TEST_EQUAL(OWHistTotal(&sH), 0) ;
+	TEST_EQUAL(OWHistPercentile(&sH, 50), 0) ;
+	OWHistReport("test", &sS) ;
+	return TEST_RESULT() ;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * test_overdrive.c - per device overdrive promotion, 2x DS28EA00 & a DS18B20 on one channel
+ */
+
+#include	"test_common.h"
+
+static owdi_t saOW[3] ;									// 2x DS28EA00 then the DS18B20
+
+int main(void) {
+	ds248xEmulAddBridge(i2cDEV_DS2482_800) ;
+	ds248xEmulAddDevice(0, 0, OWFAMILY_42, 1, testTRAW_42(0)) ;
+	ds248xEmulAddDevice(0, 0, OWFAMILY_42, 1, testTRAW_42(1)) ;
+	ds248xEmulAddDevice(0, 0, OWFAMILY_28, 1, testTRAW_28(0)) ;
+	TEST_EQUAL(ds248xEmulStart(), 1) ;
+	TEST_EQUAL(OWP_Config(), 1) ;						// DS28EA00 not a supported sensor
+
+	const uint8_t f42[] = { OWFAMILY_42 }, f28[] = { OWFAMILY_28 } ;
+	ow_rom_t aROM[3] ;
+	OWP_BusL2P(&saOW[0], 0) ;
+	TEST_EQUAL(OWP_BusSelect(&saOW[0]), 1) ;
+	TEST_EQUAL(OWSearchAll(&saOW[0], aROM, 2, f42, 1, 0), 2) ;
+	TEST_EQUAL(OWSearchAll(&saOW[0], &aROM[2], 1, f28, 1, 0), 1) ;
+	OWP_BusRelease(&saOW[0]) ;
+	for (int i = 0; i < 3; ++i) {
+		OWP_BusL2P(&saOW[i], 0) ;
+		saOW[i].ROM = aROM[i] ;
+		saOW[i].OD = (OWFamilyCaps(saOW[i].ROM.Family) & owCAP_OD) ? 1 : 0 ;
+	}
+	// TagNum[0] is the emulator index, search order need not match
+	int16_t aTraw[2] = { testTRAW_42(aROM[0].TagNum[0]), testTRAW_42(aROM[1].TagNum[0]) } ;
+
+	// each device promoted by its own Overdrive Match ROM, the other one back at standard
+	TEST_EQUAL(TestReadSP(&saOW[0], aTraw[0]), owSPEED_ODRIVE) ;
+	TEST_EQUAL(OWP_BusODGet(0), saOW[0].ROM.Value) ;
+	TEST_EQUAL(TestReadSP(&saOW[1], aTraw[1]), owSPEED_ODRIVE) ;
+	TEST_EQUAL(OWP_BusODGet(0), saOW[1].ROM.Value) ;
+	TEST_EQUAL(TestReadSP(&saOW[1], aTraw[1]), owSPEED_ODRIVE) ;	// overdrive reset, no promotion
+	TEST_EQUAL(TestReadSP(&saOW[0], aTraw[0]), owSPEED_ODRIVE) ;
+	TEST_EQUAL(saOW[0].OD + saOW[1].OD, 2) ;			// never demoted
+	TEST_EQUAL(TestReadSP(&saOW[2], testTRAW_28(0)), owSPEED_STANDARD) ;
+	TEST_EQUAL(OWP_BusODGet(0), 0) ;
+
+	// Overdrive Skip ROM promotes both, each then reached with an overdrive reset
+	TEST_EQUAL(OWP_BusSelect(&saOW[2]), 1) ;
+	TEST_EQUAL(OWReset(&saOW[2]), 1) ;
+	OWAddress(&saOW[2], OW_CMD_ODSKIPROM) ;
+	OWP_BusRelease(&saOW[2]) ;
+	TEST_EQUAL(OWP_BusODGet(0), owbiOD_ALL) ;
+	for (int i = 0; i < 2; ++i) {
+		uint16_t Rst = psaOWBI[0].Health[owbiEV_RESET] ;
+		TEST_EQUAL(TestReadSP(&saOW[i], aTraw[i]), owSPEED_ODRIVE) ;
+		TEST_EQUAL(psaOWBI[0].Health[owbiEV_RESET] - Rst, 1) ;
+		TEST_EQUAL(OWP_BusODGet(0), owbiOD_ALL) ;
+	}
+	TEST_EQUAL(TestReadSP(&saOW[2], testTRAW_28(0)), owSPEED_STANDARD) ;
+	TEST_EQUAL(OWP_BusODGet(0), 0) ;
+	return TEST_RESULT() ;
+}
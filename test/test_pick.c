@@ -0,0 +1,102 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * test_pick.c - async worker request ordering, ds248xAsyncPick() is static hence the include
+ */
+
+#include	"ds248x.c"
+#include	"test_common.h"
+
+static ds248x_t sDS248X ;
+static i2c_di_t sI2C = { .Type = i2cDEV_DS2482_800 } ;
+static ds248x_req_t saReq[ds248xASYNC_DEPTH] ;
+
+static void Init(int Count, const uint8_t * pChan, const uint8_t * pTask) {
+	memset(saReq, 0, sizeof(saReq)) ;
+	for (int i = 0; i < Count; ++i) {
+		saReq[i].Cmd	= ds248xREQ_READ ;
+		saReq[i].Chan	= pChan[i] ;
+		saReq[i].hTask	= (TaskHandle_t) (uintptr_t) pTask[i] ;
+	}
+}
+
+/**
+ * @brief	Pick until empty, check each task's and each channel's requests complete in order
+ * @return	channel selects needed
+ */
+static int Drain(int Count, uint8_t CurChan, uint8_t * pOrder) {
+	ds248x_req_t * papPend[ds248xASYNC_DEPTH] ;
+	for (int i = 0; i < Count; ++i) papPend[i] = &saReq[i] ;
+	sDS248X.psI2C = &sI2C ;
+	sDS248X.CurChan = CurChan ;
+	uint8_t Bypass = 0 ;
+	int Chsl = 0, Done = 0 ;
+	while (Count) {
+		int Idx = ds248xAsyncPick(&sDS248X, papPend, Count, 0, NULL, &Bypass) ;
+		ds248x_req_t * psReq = papPend[Idx] ;
+		memmove(&papPend[Idx], &papPend[Idx + 1], (Count - Idx - 1) * sizeof(ds248x_req_t *)) ;
+		--Count ;
+		for (int i = 0; i < Count; ++i) {				// nothing older left behind on same task/channel
+			if (papPend[i] > psReq) continue ;
+			TEST_CHECK(papPend[i]->hTask != psReq->hTask) ;
+			TEST_CHECK(papPend[i]->Chan != psReq->Chan) ;
+		}
+		if (psReq->Chan != sDS248X.CurChan) ++Chsl ;
+		sDS248X.CurChan = psReq->Chan ;
+		pOrder[Done++] = psReq - saReq ;
+		printf("%d(c%d) ", (int) (psReq - saReq), psReq->Chan) ;
+	}
+	printf(" CHSL=%d\n", Chsl) ;
+	return Chsl ;
+}
+
+int main(void) {
+	uint8_t aOrder[ds248xASYNC_DEPTH] ;
+	// tasks interleaving channels, grouping by channel saves selects
+	const uint8_t aChan1[12] = { 1, 2, 1, 2, 3, 1, 3, 1, 2, 2, 1, 3 } ;
+	uint8_t aTask1[12] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 } ;
+	aTask1[7] = aTask1[6] ;								// 7 (c1) may not overtake 6 (c3), same task
+	Init(12, aChan1, aTask1) ;
+	TEST_CHECK(Drain(12, 0, aOrder) < 9) ;				// 9 in submission order
+	TEST_CHECK(sDS248X.ReOrder > 0) ;
+
+	// PRIO requests overtake other channels, not their own task's earlier requests
+	const uint8_t aChan2[6] = { 1, 1, 2, 3, 1, 2 } ;
+	const uint8_t aTask2[6] = { 1, 2, 3, 4, 5, 3 } ;
+	Init(6, aChan2, aTask2) ;
+	saReq[3].Flags = saReq[5].Flags = ds248xREQF_PRIO ;
+	Drain(6, 1, aOrder) ;
+	TEST_EQUAL(aOrder[0], 3) ;
+	TEST_CHECK(aOrder[1] == 2 || aOrder[1] == 0) ;		// 5 waits for 2 (same task)
+
+	// nor other tasks' earlier requests for the same channel, nor EXEC jobs
+	const uint8_t aChan4[5] = { 2, 1, 2, 3, 3 } ;
+	const uint8_t aTask4[5] = { 1, 2, 3, 4, 5 } ;
+	Init(5, aChan4, aTask4) ;
+	saReq[2].Flags = saReq[4].Flags = ds248xREQF_PRIO ;
+	saReq[3].Cmd = ds248xREQ_EXEC ;
+	Drain(5, 2, aOrder) ;
+	TEST_EQUAL(aOrder[0], 0) ;							// 2 waits for 0 (channel 2)
+	TEST_EQUAL(aOrder[1], 2) ;
+	for (int i = 0; i < 5; ++i) if (aOrder[i] == 4) TEST_CHECK(i > 0 && aOrder[i - 1] == 3) ;	// 4 waits for EXEC 3
+
+	// HOLD sequence of task 1 on channel 1, other tasks wait even for the held channel
+	const uint8_t aChan3[4] = { 1, 1, 2, 1 } ;
+	const uint8_t aTask3[4] = { 2, 3, 2, 1 } ;
+	Init(4, aChan3, aTask3) ;
+	ds248x_req_t * papPend[4] = { &saReq[0], &saReq[1], &saReq[2], &saReq[3] } ;
+	uint8_t Bypass = 0 ;
+	sDS248X.CurChan = 1 ;
+	TEST_EQUAL(ds248xAsyncPick(&sDS248X, papPend, 4, 1, (TaskHandle_t) 1, &Bypass), 3) ;
+	TEST_EQUAL(ds248xAsyncPick(&sDS248X, papPend, 3, 1, (TaskHandle_t) 1, &Bypass), -1) ;
+	TEST_EQUAL(ds248xAsyncPick(&sDS248X, papPend, 3, 0, NULL, &Bypass), 0) ;
+
+	// a single channel bridge is strictly FIFO
+	sI2C.Type = i2cDEV_DS2484 ;
+	Init(6, (const uint8_t[6]) { 0 }, aTask1) ;
+	Drain(6, 0, aOrder) ;
+	for (int i = 0; i < 6; ++i) TEST_EQUAL(aOrder[i], i) ;
+	return TEST_RESULT() ;
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * test_platform.c - enumeration & temperature cycle of the reference installation
+ */
+
+#include	"test_common.h"
+
+int main(void) {
+	TEST_EQUAL(TestRig(1), 3) ;
+	uint64_t t0 = ds248xEmulMicros() ;
+	TEST_EQUAL(OWP_Config(), 19) ;						// 16 + 2 DS18x20 & 1 DS1990
+	printf("OWP_Config: %uuS  Trans=%u\n", (uint32_t) (ds248xEmulMicros() - t0), ds248xEmulTrans()) ;
+	TEST_EQUAL(Fam10_28Count, 18) ;
+	TEST_CHECK(ds248xEmulTrans() < 2500) ;
+	for (int i = 1; i < Fam10_28Count; ++i) {			// single pass enumeration, bus order
+		TEST_CHECK(OWP_BusP2L(&psaDS18X20[i - 1].sOW) <= OWP_BusP2L(&psaDS18X20[i].sOW)) ;
+	}
+	for (int i = 0; i < Fam10_28Count; ++i) TEST_EQUAL(psaDS18X20[i].Pwr, 1) ;
+
+	ds248xEmulResetCounters() ;
+	t0 = ds248xEmulMicros() ;
+	OWP_TempAllInOne(NULL) ;
+	printf("OWP_TempAllInOne: %uuS  Trans=%u\n", (uint32_t) (ds248xEmulMicros() - t0), ds248xEmulTrans()) ;
+	TestCheckTemps() ;
+	// CHSL, reset, match ROM & command (10), 9 data bytes each STAT polled then DATA read, 3 polls
+	TEST_CHECK(ds248xEmulBenchmark() <= 2 + 10 + (9 * 2) + 3) ;
+	ds248xEmulReport() ;
+	OWP_ReportHealth() ;
+	return TEST_RESULT() ;
+}
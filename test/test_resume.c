@@ -0,0 +1,80 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * test_resume.c - Resume ROM tracking, ds248xAsyncExecute() is static hence the include
+ */
+
+#include	"ds248x.c"
+#include	"test_common.h"
+
+static owdi_t saOW[2] ;									// 2x DS28EA00, Resume capable
+static int16_t aTraw[2] ;
+
+/**
+ * @brief	Read device Idx, check it was addressed with Resume (Resume == 1) or Match ROM
+ */
+static void ReadCheck(int Idx, bool Resume) {
+	uint16_t Count = psaOWBI[0].Health[owbiEV_RESUME] ;
+	TestReadSP(&saOW[Idx], aTraw[Idx]) ;
+	TEST_EQUAL(psaOWBI[0].Health[owbiEV_RESUME] - Count, Resume) ;
+	TEST_EQUAL(OWP_BusResumeGet(0), saOW[Idx].ROM.Value) ;
+}
+
+/**
+ * @brief	Reset & Skip ROM as asynchronous requests, executed the way the device worker would
+ */
+static void AsyncSkip(void) {
+	ds248x_t * psDS248X = ds248xDEV(0) ;
+	ds248x_req_t sReq = { .Cmd = ds248xREQ_RESET, .Chan = 0 } ;
+	TEST_EQUAL(ds248xBusSelect(psDS248X, sReq.Chan), 1) ;
+	ds248xAsyncExecute(psDS248X, &sReq) ;
+	TEST_EQUAL(sReq.Rdata, 1) ;
+	sReq.Cmd = ds248xREQ_WRITE ;
+	sReq.Data = OW_CMD_SKIPROM ;						// clears RC flags of all devices
+	ds248xAsyncExecute(psDS248X, &sReq) ;
+	TEST_EQUAL(sReq.iRV, 1) ;
+	ds248xBusRelease(psDS248X) ;
+}
+
+int main(void) {
+	ds248xEmulAddBridge(i2cDEV_DS2482_10X) ;
+	ds248xEmulAddDevice(0, 0, OWFAMILY_42, 1, testTRAW_42(0)) ;
+	ds248xEmulAddDevice(0, 0, OWFAMILY_42, 1, testTRAW_42(1)) ;
+	ds248xEmulAddDevice(0, 0, OWFAMILY_28, 1, testTRAW_28(0)) ;
+	TEST_EQUAL(ds248xEmulStart(), 1) ;
+	TEST_EQUAL(OWP_Config(), 1) ;						// DS28EA00 not a supported sensor
+
+	const uint8_t f42[] = { OWFAMILY_42 } ;
+	ow_rom_t aROM[2] ;
+	OWP_BusL2P(&saOW[0], 0) ;
+	TEST_EQUAL(OWP_BusSelect(&saOW[0]), 1) ;
+	TEST_EQUAL(OWSearchAll(&saOW[0], aROM, 2, f42, 1, 0), 2) ;
+	OWP_BusRelease(&saOW[0]) ;
+	for (int i = 0; i < 2; ++i) {
+		OWP_BusL2P(&saOW[i], 0) ;						// standard speed, Resume only
+		saOW[i].ROM = aROM[i] ;
+		aTraw[i] = testTRAW_42(aROM[i].TagNum[0]) ;
+	}
+
+	ReadCheck(0, 0) ;									// Match ROM sets the RC flag
+	ReadCheck(0, 1) ;
+	ReadCheck(1, 0) ;									// RC moves to the other device
+	ReadCheck(0, 0) ;
+	ReadCheck(0, 1) ;
+
+	TEST_EQUAL(OWP_BusSelect(&saOW[0]), 1) ;			// search clears all RC flags
+	owdi_t sOW = saOW[0] ;
+	TEST_EQUAL(OWFirst(&sOW, 0), 1) ;
+	OWP_BusRelease(&saOW[0]) ;
+	TEST_EQUAL(OWP_BusResumeGet(0), 0) ;
+	ReadCheck(0, 0) ;
+	ReadCheck(0, 1) ;
+
+	AsyncSkip() ;										// ROM traffic outside OWAddress()
+	TEST_EQUAL(OWP_BusResumeGet(0), 0) ;
+	ReadCheck(0, 0) ;
+	ReadCheck(0, 1) ;
+	return TEST_RESULT() ;
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * test_search.c - OWSearchAll() family filters & OWSearchDelta() topology changes
+ */
+
+#include	"test_common.h"
+
+static owdi_t sOW ;
+
+static int Search(const char * pcName, const uint8_t * paFam, int FamNum, ow_rom_t * paROM, int Size) {
+	OWP_BusSelect(&sOW) ;
+	uint64_t t0 = ds248xEmulMicros() ;
+	int Count = OWSearchAll(&sOW, paROM, Size, paFam, FamNum, 0) ;
+	OWP_BusRelease(&sOW) ;
+	printf("%-8s n=%d %uuS :", pcName, Count, (uint32_t) (ds248xEmulMicros() - t0)) ;
+	for (int i = 0; i < (Count < Size ? Count : Size); ++i) {
+		printf(" %02X.%02X%02X", paROM[i].Family, paROM[i].HexChars[2], paROM[i].HexChars[1]) ;
+		if (i) TEST_CHECK(OWRomCompare(&paROM[i - 1], &paROM[i]) < 0) ;
+		TEST_CHECK(paFam == NULL || paROM[i].Family == paFam[0] || (FamNum > 1 && paROM[i].Family == paFam[1])) ;
+	}
+	printf("\n") ;
+	return Count ;
+}
+
+static int Delta(const char * pcName, const ow_rom_t * paKnown, int Known, int Expect) {
+	ow_rom_t aROM[16] ;
+	int Count = -1 ;
+	OWP_BusSelect(&sOW) ;
+	uint64_t t0 = ds248xEmulMicros() ;
+	int Changes = OWSearchDelta(&sOW, paKnown, Known, aROM, NO_MEM(aROM), &Count) ;
+	OWP_BusRelease(&sOW) ;
+	printf("%-8s changes=%d count=%d %uuS\n", pcName, Changes, Count, (uint32_t) (ds248xEmulMicros() - t0)) ;
+	TEST_EQUAL(Changes, Expect) ;
+	return Count ;
+}
+
+int main(void) {
+	const uint8_t aFam[8] = { 0x28, 0x10, 0x28, 0x01, 0x28, 0x10, 0x28, 0x01 } ;
+	ds248xEmulAddBridge(i2cDEV_DS2482_800) ;
+	for (int i = 0; i < NO_MEM(aFam); ++i) ds248xEmulAddDevice(0, 0, aFam[i], 1, testTRAW_28(0)) ;
+	for (int i = 0; i < NO_MEM(aFam) - 1; ++i) ds248xEmulAddDevice(0, 1, aFam[i], 1, testTRAW_28(1)) ;
+	TEST_EQUAL(ds248xEmulStart(), 1) ;
+	TEST_EQUAL(OWP_Config(), 15) ;
+	OWP_BusL2P(&sOW, 0) ;
+
+	const uint8_t f28[] = { 0x28 }, f10[] = { 0x10 }, f1028[] = { 0x10, 0x28 }, f01[] = { 0x01 }, f99[] = { 0x99 } ;
+	ow_rom_t aROM[16] ;
+	TEST_EQUAL(Search("all", NULL, 0, aROM, 16), 8) ;
+	TEST_EQUAL(Search("28", f28, 1, aROM, 16), 4) ;
+	TEST_EQUAL(Search("10", f10, 1, aROM, 16), 2) ;
+	TEST_EQUAL(Search("10+28", f1028, 2, aROM, 16), 6) ;
+	TEST_EQUAL(Search("01", f01, 1, aROM, 16), 2) ;
+	TEST_EQUAL(Search("99", f99, 1, aROM, 16), 0) ;
+	TEST_EQUAL(Search("all/3", NULL, 0, aROM, 3), 8) ;	// lowest 3 kept, all counted
+
+	// overdrive believed active, devices back at standard speed: demote & search again
+	OWP_BusSelect(&sOW) ;
+	sOW.OD = 1 ;
+	OWP_BusODSet(OWP_BusP2L(&sOW), owbiOD_ALL) ;
+	TEST_EQUAL(OWFirst(&sOW, 0), 1) ;
+	TEST_EQUAL(sOW.OD, 0) ;
+	TEST_EQUAL(ds248xDEV(sOW.DevNum)->OWS, owSPEED_STANDARD) ;
+	OWP_BusRelease(&sOW) ;
+
+	OWP_BusL2P(&sOW, 1) ;								// 7 devices, room for 1 more
+	ow_rom_t aKnown[16], aX[16] ;
+	int Known = Search("known", NULL, 0, aKnown, 16) ;
+	Delta("stable", aKnown, Known, 0) ;
+	Delta("missing", aKnown, Known - 1, 1) ;			// bus has one more than known
+	memcpy(aX, aKnown, sizeof(aKnown)) ;
+	aX[2].HexChars[1] ^= 0x80 ;							// known device replaced
+	aX[2].CRC = OWCrc8(0, aX[2].HexChars, 7) ;
+	Delta("replaced", aX, Known, 2) ;
+	Delta("empty", NULL, 0, Known) ;
+	ds248xEmulAddDevice(0, 1, OWFAMILY_28, 1, testTRAW_28(0)) ;
+	TEST_EQUAL(Delta("hotplug", aKnown, Known, 1), Known + 1) ;
+	return TEST_RESULT() ;
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2021 Andre M. Maree/KSS Technologies (Pty) Ltd.
+ */
+
+/*
+ * test_trace.c - record a temperature cycle in the transaction trace and replay it
+ */
+
+#include	"test_common.h"
+
+static uint8_t aTrace[8192] ;
+
+int main(void) {
+	ds248xEmulAddBridge(i2cDEV_DS2484) ;
+	ds248xEmulAddDevice(0, 0, OWFAMILY_28, 1, 0x0200) ;
+	ds248xEmulAddDevice(0, 0, OWFAMILY_28, 0, 0x0210) ;	// parasitic, SPU in the trace
+	ds248xTraceEnable(0) ;								// cycle only, replayed from the same bus state
+	TEST_EQUAL(ds248xEmulStart(), 1) ;
+	TEST_EQUAL(OWP_Config(), 2) ;
+	ds248xTraceEnable(1) ;
+	OWP_TempAllInOne(NULL) ;
+	TEST_CHECK(psaDS18X20[0].sEWx.var.val.x32.f32 == 32.0) ;
+	TEST_CHECK(psaDS18X20[1].sEWx.var.val.x32.f32 == 33.0) ;
+	size_t Size = ds248xTraceExport(aTrace, sizeof(aTrace)) ;
+	ds248xTraceEnable(0) ;
+	TEST_CHECK(Size > sizeof(ds248x_trace_hdr_t)) ;
+	TEST_CHECK(Size <= sizeof(aTrace)) ;
+	ds248xTraceReport(8) ;
+	TEST_EQUAL(ds248xEmulReplay(aTrace, Size), 0) ;		// same bridges answer the same way
+	aTrace[Size - sizeof(ds248x_trace_t) + offsetof(ds248x_trace_t, Rx)] ^= 0xFF ;
+	TEST_EQUAL(ds248xEmulReplay(aTrace, Size), 1) ;		// corrupted record detected
+	return TEST_RESULT() ;
+}